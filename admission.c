@@ -0,0 +1,234 @@
+// Online admission control - see admission.h
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "admission.h"
+
+// Ids the service table starts with, doubled as it fills
+#define ADMISSION_INITIAL_IDS 64
+
+/* Set up a controller with numCores empty cores that places services by the given partitioning heuristic.  Returns FALSE if
+ * memory ran out or there are no cores.
+ */
+int admission_init(admission_t *adm, U32_T numCores, int heuristic)
+{
+    memset(adm, 0, sizeof(*adm));
+    partition_init(&adm->part);
+    adm->heuristic = heuristic;
+    adm->freeId = ADMISSION_NO_ID;
+
+    if(numCores == 0 || !partition_clear(&adm->part, numCores))
+    {
+        partition_free(&adm->part);
+        return FALSE;
+    }
+
+    pthread_mutex_init(&adm->lock, NULL);
+    pthread_cond_init(&adm->applied, NULL);
+    return TRUE;
+}
+
+void admission_free(admission_t *adm)
+{
+    partition_free(&adm->part);
+    free(adm->services);
+    pthread_mutex_destroy(&adm->lock);
+    pthread_cond_destroy(&adm->applied);
+}
+
+// A free id for a new service, reusing released ones first, or ADMISSION_NO_ID if memory ran out
+static U32_T admission_new_id(admission_t *adm)
+{
+    admission_service_t *p;
+    U32_T id, newCapacity;
+
+    if((id = adm->freeId) != ADMISSION_NO_ID)
+    {
+        adm->freeId = adm->services[id].period;
+        return id;
+    }
+
+    if(adm->numIds == adm->idCapacity)
+    {
+        newCapacity = adm->idCapacity ? 2 * adm->idCapacity : ADMISSION_INITIAL_IDS;
+        if(newCapacity <= adm->idCapacity || newCapacity == ADMISSION_NO_ID)
+            return ADMISSION_NO_ID;
+        if((p = realloc(adm->services, newCapacity * sizeof(admission_service_t))) == NULL)
+            return ADMISSION_NO_ID;
+        adm->services = p;
+        adm->idCapacity = newCapacity;
+    }
+
+    return adm->numIds++;
+}
+
+static int admission_known(const admission_t *adm, U32_T id)
+{
+    return id < adm->numIds && adm->services[id].core != PARTITION_UNASSIGNED;
+}
+
+// Apply one request to the partition; only the thread applying the current batch gets here
+static void admission_apply(admission_t *adm, admission_request_t *req)
+{
+    admission_service_t *s;
+    U32_T id, core;
+
+    req->result = FALSE;
+    switch(req->op)
+    {
+        case ADMISSION_ADD:
+            req->id = ADMISSION_NO_ID;
+            req->core = PARTITION_UNASSIGNED;
+            req->response = RTA_RESPONSE_UNKNOWN;
+            // no job can complete by a deadline of 0; longer deadlines than periods are placed on the whole busy period
+            if(req->period == 0 || req->deadline == 0)
+                break;
+            if((id = admission_new_id(adm)) == ADMISSION_NO_ID)
+            {
+                req->result = -1;
+                break;
+            }
+
+            core = partition_place(&adm->part, req->period, req->wcet, req->deadline, adm->heuristic);
+            if(core == PARTITION_UNASSIGNED)
+            {
+                adm->services[id].core = PARTITION_UNASSIGNED;
+                adm->services[id].period = adm->freeId;
+                adm->freeId = id;
+                break;
+            }
+
+            s = &adm->services[id];
+            s->core = core;
+            s->period = req->period;
+            s->wcet = req->wcet;
+            s->deadline = req->deadline;
+            adm->numAdmitted++;
+
+            req->id = id;
+            req->core = core;
+            req->response = partition_response_time(&adm->part, core, s->period, s->wcet, s->deadline);
+            req->result = TRUE;
+            break;
+
+        case ADMISSION_REMOVE:
+            if(!admission_known(adm, req->id))
+                break;
+            s = &adm->services[req->id];
+            partition_withdraw(&adm->part, s->core, s->period, s->wcet, s->deadline, adm->heuristic);
+            req->core = s->core;
+            req->response = RTA_RESPONSE_UNKNOWN;
+
+            s->core = PARTITION_UNASSIGNED;
+            s->period = adm->freeId;
+            adm->freeId = req->id;
+            adm->numAdmitted--;
+            req->result = TRUE;
+            break;
+
+        case ADMISSION_QUERY:
+            req->core = PARTITION_UNASSIGNED;
+            req->response = RTA_RESPONSE_UNKNOWN;
+            if(!admission_known(adm, req->id))
+                break;
+            s = &adm->services[req->id];
+            req->core = s->core;
+            req->response = partition_response_time(&adm->part, s->core, s->period, s->wcet, s->deadline);
+            req->result = TRUE;
+            break;
+    }
+}
+
+/* Answer count requests, applied in order after every request queued before them.  The calling thread queues them and either
+ * waits while another thread applies them or, when no batch is being applied, takes everything queued and applies it itself.
+ */
+void admission_submit(admission_t *adm, admission_request_t requests[], U32_T count)
+{
+    admission_request_t *batch, *req;
+    U32_T idx;
+
+    if(count == 0)
+        return;
+
+    for(idx=0; idx < count; idx++)
+    {
+        requests[idx].done = FALSE;
+        requests[idx].next = (idx+1 < count) ? &requests[idx+1] : NULL;
+    }
+
+    pthread_mutex_lock(&adm->lock);
+    if(adm->tail)
+        adm->tail->next = &requests[0];
+    else
+        adm->head = &requests[0];
+    adm->tail = &requests[count-1];
+
+    while(!requests[count-1].done)
+    {
+        if(adm->busy)
+        {
+            pthread_cond_wait(&adm->applied, &adm->lock);
+            continue;
+        }
+
+        // the queue is taken whole, so no request can be left behind while the applying thread is unlocked
+        adm->busy = TRUE;
+        batch = adm->head;
+        adm->head = adm->tail = NULL;
+        pthread_mutex_unlock(&adm->lock);
+
+        for(req=batch; req; req=req->next)
+        {
+            admission_apply(adm, req);
+            adm->numRequests++;
+        }
+        adm->numBatches++;
+
+        pthread_mutex_lock(&adm->lock);
+        for(req=batch; req; req=req->next)
+            req->done = TRUE;
+        adm->busy = FALSE;
+        pthread_cond_broadcast(&adm->applied);
+    }
+    pthread_mutex_unlock(&adm->lock);
+}
+
+/* Admit one service if every core it could go on stays feasible with it.  Returns TRUE with its id and core (either may be
+ * NULL), FALSE when no core can take it, and -1 if memory ran out.
+ */
+int admission_add(admission_t *adm, U32_T period, U32_T wcet, U32_T deadline, U32_T *id, U32_T *core)
+{
+    admission_request_t req = {ADMISSION_ADD, period, wcet, deadline};
+
+    admission_submit(adm, &req, 1);
+    if(id)
+        *id = req.id;
+    if(core)
+        *core = req.core;
+    return req.result;
+}
+
+// Release an admitted service; FALSE when the id is not one
+int admission_remove(admission_t *adm, U32_T id)
+{
+    admission_request_t req = {ADMISSION_REMOVE};
+
+    req.id = id;
+    admission_submit(adm, &req, 1);
+    return req.result;
+}
+
+// The core and worst case response time of an admitted service; FALSE when the id is not one
+int admission_response_time(admission_t *adm, U32_T id, U32_T *core, U64_T *response)
+{
+    admission_request_t req = {ADMISSION_QUERY};
+
+    req.id = id;
+    admission_submit(adm, &req, 1);
+    if(core)
+        *core = req.core;
+    if(response)
+        *response = req.response;
+    return req.result;
+}
@@ -0,0 +1,84 @@
+// Online admission control
+//
+// A long-lived controller for services that arrive and leave at runtime.  It keeps a partition of the admitted services over a
+// fixed number of cores in memory, each core as an rta_state_t with its cached response times, so a request only analyzes the
+// core it touches and, within that core, the services at or below the priority of the one added or removed:
+//
+//     ADMISSION_ADD     place a service with partition_place (exact completion test per core, FF, BF or WF, over the
+//                       whole busy period when a deadline is beyond its period); admitted services get an id, rejected
+//                       ones, including any with a period or deadline of 0, leave every core exactly as it was
+//     ADMISSION_REMOVE  release a service by id; the services below it on its core only get faster
+//     ADMISSION_QUERY   the core and current worst case response time of a service
+//
+// Requests from any number of threads go through admission_submit.  Requests that arrive while another thread is applying a
+// batch are queued, and the next thread to find the controller free applies everything queued in arrival order in one pass
+// (flat combining), so concurrent callers share one lock handoff per batch instead of contending per request.  The analysis
+// itself runs on one thread at a time, so the per-core states need no locking of their own.
+//
+// Each call answers its requests in place and returns when all of them are done.
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <pthread.h>
+
+#include "feasibility.h"
+#include "partition.h"
+
+#define ADMISSION_ADD 0
+#define ADMISSION_REMOVE 1
+#define ADMISSION_QUERY 2
+
+// Id of no service
+#define ADMISSION_NO_ID (~0U)
+
+typedef struct admission_request
+{
+    int op;                     // ADMISSION_*
+    U32_T period;               // the service to add
+    U32_T wcet;
+    U32_T deadline;
+    U32_T id;                   // the service to remove or query, or the id an admitted service was given
+    int result;                 // TRUE when done as asked, FALSE when rejected or the id is unknown, -1 if memory ran out
+    U32_T core;                 // core of the service added or queried
+    U64_T response;             // its response time after the request (for a query)
+    struct admission_request *next; // queue link, private to the controller
+    int done;
+} admission_request_t;
+
+// An admitted service, or a free id when core is PARTITION_UNASSIGNED (period then links to the next free id)
+typedef struct
+{
+    U32_T core;
+    U32_T period;
+    U32_T wcet;
+    U32_T deadline;
+} admission_service_t;
+
+typedef struct
+{
+    partition_t part;
+    int heuristic;
+    admission_service_t *services;  // by id
+    U32_T numIds;
+    U32_T idCapacity;
+    U32_T freeId;               // first free id, or ADMISSION_NO_ID
+    U32_T numAdmitted;
+    U64_T numBatches;           // batches applied, and the requests in them
+    U64_T numRequests;
+    pthread_mutex_t lock;       // guards the queue below
+    pthread_cond_t applied;
+    admission_request_t *head;
+    admission_request_t *tail;
+    int busy;                   // a thread is applying a batch
+} admission_t;
+
+int admission_init(admission_t *adm, U32_T numCores, int heuristic);
+void admission_free(admission_t *adm);
+void admission_submit(admission_t *adm, admission_request_t requests[], U32_T count);
+
+int admission_add(admission_t *adm, U32_T period, U32_T wcet, U32_T deadline, U32_T *id, U32_T *core);
+int admission_remove(admission_t *adm, U32_T id);
+int admission_response_time(admission_t *adm, U32_T id, U32_T *core, U64_T *response);
+
+#endif
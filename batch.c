@@ -0,0 +1,1671 @@
+// Streaming batch mode for the feasibility tests - see batch.h for the input format
+
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "batch.h"
+#include "context.h"
+#include "edf.h"
+#include "gen.h"
+#include "global.h"
+#include "mixedcrit.h"
+#include "parallel.h"
+#include "partition.h"
+#include "priority.h"
+#include "rta.h"
+#include "sensitivity.h"
+#include "server.h"
+#include "setfile.h"
+#include "sim.h"
+#include "tiered.h"
+
+// The utilization and dm quick test take their arrays in a different order, so adapt them to the common signature
+static int edf_llf_test(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    (void)deadline;
+    return utilization_100_test(numServices, period, wcet);
+}
+
+static int dm_test(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return dm_quick_test(numServices, wcet, period, deadline);
+}
+
+typedef struct
+{
+    const char *name;
+    feasibility_test_fn fn;
+    const char *description;
+    int simPolicy;          // policy for the simulation tests, -1 for the analytical ones
+    int special;            // for a test without fn, which of the analyses batch_run_set calls itself
+    int (*contextFn)(feasibility_context_t *ctx);   // the same test taking its set-wide values from the set's context
+} batch_test_t;
+
+// Tests that need more than the common signature passes (the overheads or a core count), run by batch_run_set itself
+#define BATCH_SPECIAL_OVERHEADS 1
+#define BATCH_SPECIAL_GLOBAL_FP 2
+#define BATCH_SPECIAL_GLOBAL_EDF 3
+#define BATCH_SPECIAL_AMC_RTB 4
+#define BATCH_SPECIAL_AMC_MAX 5
+
+// Cores for the global tests when -M is not given
+#define DEFAULT_GLOBAL_CORES 2
+
+// The tiered test through the set's context; the tier that decided it is counted in tiered_counters
+static int batch_tiered_test(feasibility_context_t *ctx)
+{
+    return tiered_feasibility_context(ctx, NULL);
+}
+
+static const batch_test_t batch_tests[] =
+{
+    {.name = "ct",      .fn = completion_time_feasibility,      .description = "completion time test (exact, RM/DM)",
+     .simPolicy = -1},
+    {.name = "ct-o",    .description = "completion time test with jitter, blocking and -O switch cost", .simPolicy = -1,
+     .special = BATCH_SPECIAL_OVERHEADS},
+    {.name = "sp",      .fn = scheduling_point_feasibility,     .description = "scheduling point test (exact, RM/DM)",
+     .simPolicy = -1},
+    {.name = "lub",     .fn = rate_monotonic_least_upper_bound, .description = "RM least upper bound (sufficient)",
+     .simPolicy = -1, .contextFn = context_lub_test},
+    {.name = "edf",     .fn = edf_llf_test,
+     .description = "EDF/LLF 100% utilization test (exact only for D=T)", .simPolicy = -1,
+     .contextFn = context_utilization_100_test},
+    {.name = "qpa",     .fn = edf_demand_feasibility,           .description = "EDF processor demand test by QPA (exact)",
+     .simPolicy = -1},
+    {.name = "dm",      .fn = dm_test,                          .description = "DM quick test, eq. 3.14 (sufficient)",
+     .simPolicy = -1},
+    {.name = "tier",    .fn = tiered_feasibility,
+     .description = "tiered: U > 1, hyperbolic and harmonic chain bounds, then ct (exact)", .simPolicy = -1,
+     .contextFn = batch_tiered_test},
+    {.name = "g-fp",    .description = "global fixed priority on -M cores, RTA-LC (sufficient)", .simPolicy = -1,
+     .special = BATCH_SPECIAL_GLOBAL_FP},
+    {.name = "g-edf",   .description = "global EDF on -M cores, iterative RTA (sufficient)", .simPolicy = -1,
+     .special = BATCH_SPECIAL_GLOBAL_EDF},
+    {.name = "amc-rtb", .description = "mixed criticality AMC-rtb with the C/CH WCETs (sufficient)", .simPolicy = -1,
+     .special = BATCH_SPECIAL_AMC_RTB},
+    {.name = "amc-max", .description = "mixed criticality AMC-max with the C/CH WCETs (sufficient)", .simPolicy = -1,
+     .special = BATCH_SPECIAL_AMC_MAX},
+    {.name = "sim-rm",  .fn = sim_rm_feasibility,  .description = "simulate one hyperperiod under RM",  .simPolicy = SIM_RM},
+    {.name = "sim-dm",  .fn = sim_dm_feasibility,  .description = "simulate one hyperperiod under DM",  .simPolicy = SIM_DM},
+    {.name = "sim-edf", .fn = sim_edf_feasibility, .description = "simulate one hyperperiod under EDF", .simPolicy = SIM_EDF},
+    {.name = "sim-llf", .fn = sim_llf_feasibility, .description = "simulate one hyperperiod under LLF", .simPolicy = SIM_LLF},
+};
+
+#define NUM_BATCH_TESTS ((int)(sizeof(batch_tests)/sizeof(batch_tests[0])))
+#define DEFAULT_BATCH_TESTS "ct,sp,lub"
+
+// Result line formats
+#define FORMAT_TEXT 0
+#define FORMAT_CSV 1
+#define FORMAT_JSONL 2
+
+// Quarter octave buckets of the time one test took on one set, for the -P summary: times below 8 ns each have their own bucket,
+// and above that bucket 4*floor(log2(ns)) + f holds [(4 + f) * 2^(floor(log2(ns)) - 2), (5 + f) * 2^(floor(log2(ns)) - 2))
+#define BATCH_TIME_BUCKETS 256
+
+// Work and time of one test on one set, for -P
+typedef struct
+{
+    U64_T iterations;
+    U64_T points;
+    U64_T divisions;
+    U64_T ns;
+    U64_T cycles;       // time stamp counter ticks, 0 where there is none
+} batch_profile_t;
+
+// The distribution of one test's time over the sets a worker analyzed, with the slowest of them
+typedef struct
+{
+    U64_T histogram[BATCH_TIME_BUCKETS];
+    U64_T maxNs;
+    unsigned long maxSetNo;
+    char maxLabel[BATCH_LABEL_MAX];
+} batch_time_profile_t;
+
+static const char *format_names[] = {"text", "csv", "jsonl"};
+static const char *verbosity_names[] = {"silent", "summary", "trace"};
+static const char *engine_names[] = {"reference", "optimized"};
+
+static int lookup_name(const char *name, const char *names[], int count)
+{
+    int idx;
+
+    for(idx=0; idx < count; idx++)
+        if(strcmp(name, names[idx]) == 0)
+            return idx;
+    return -1;
+}
+
+static void batch_usage(FILE *out, const char *prog)
+{
+    int idx;
+
+    fprintf(out, "usage: %s [-b] [-f FILE] [-t TEST[,TEST...]] [-o FORMAT] [-v LEVEL] [-r [-s]] [-S] [-e ENGINE]\n"
+                 "          [-m] [-P] [-O COST] [-T TIE] [-Q QUANTUM] [-M CORES] [-p POLICY] [-c CORES [-H HEURISTIC]] [-j JOBS]\n"
+                 "          [-a SPEC] [-g SPEC [-W]] [-B FILE]\n", prog);
+    fprintf(out, "  -b, --batch           read task sets from stdin (the default when no file is given)\n");
+    fprintf(out, "  -f, --input FILE      read task sets from FILE\n");
+    fprintf(out, "  -t, --tests LIST      comma separated tests to run, or \"all\" (default %s)\n", DEFAULT_BATCH_TESTS);
+    fprintf(out, "  -o, --format FORMAT   result format: text, csv or jsonl (default text)\n");
+    fprintf(out, "  -v, --verbosity LEVEL silent, summary (adds run totals) or trace (adds kernel working); default silent\n");
+    fprintf(out, "  -r, --response-times  also report the worst case response time of every service (priority order)\n");
+    fprintf(out, "  -s, --stop-on-miss    with -r, stop the analysis at the first service to miss its deadline\n");
+    fprintf(out, "  -S, --sim-stats       with the sim-* tests, also report misses, preemptions, context switches and the\n");
+    fprintf(out, "                        time spent switching\n");
+    fprintf(out, "  -T, --tie RULE        sim-* tie breaking between equal priorities: index (lower service, the default),\n");
+    fprintf(out, "                        running (never preempt on a tie) or deadline (earlier deadline, then running)\n");
+    fprintf(out, "  -Q, --quantum Q       sim-llf compares laxities only every Q ticks (default 1)\n");
+    fprintf(out, "  -m, --margins         also report the sensitivity of each set in priority order: the critical WCET\n");
+    fprintf(out, "                        scaling factor and, for a feasible set, the largest WCET and shortest period\n");
+    fprintf(out, "                        of each service with the others unchanged\n");
+    fprintf(out, "  -a, --server SPEC     also report the largest aperiodic server budget each set can take, the server's\n");
+    fprintf(out, "                        response time and the response time bound of an aperiodic request; SPEC is\n");
+    fprintf(out, "                        key=value,... from kind (ps, ds or ss, polling, deferrable or sporadic; default ss),\n");
+    fprintf(out, "                        period, level (server priority, 0 highest) and demand (default one budget)\n");
+    fprintf(out, "  -P, --profile         also report the work and time of each test on each set: fixed point iterations,\n");
+    fprintf(out, "                        points, divisions, ns and TSC cycles; -v summary adds their time distribution\n");
+    fprintf(out, "  -O, --switch-cost C   context switch cost, charged twice per job by ct-o and per switch by sim-* (default 0)\n");
+    fprintf(out, "  -M, --global-cores M  cores shared by the services for g-fp and g-edf (default %d)\n", DEFAULT_GLOBAL_CORES);
+    fprintf(out, "  -e, --engine ENGINE   exact test kernels: optimized (integer, the default) or reference (original)\n");
+    fprintf(out, "  -p, --priority POLICY reorder each set by rm, dm or opa (Audsley) priorities before the tests;\n");
+    fprintf(out, "                        by default the services are taken highest priority first as listed\n");
+    fprintf(out, "  -c, --cores N         also partition each set over N cores (0 for the fewest that work), using the\n");
+    fprintf(out, "                        completion test per core; reports the core map and per-core utilization\n");
+    fprintf(out, "  -H, --heuristic NAME  partitioning heuristic: ff, bf or wf (first, best or worst fit decreasing)\n");
+    fprintf(out, "  -j, --jobs N          analyze the sets on N threads (0 for one per CPU); results keep the input order.\n");
+    fprintf(out, "                        -v trace always runs on one thread\n");
+    fprintf(out, "  -g, --generate SPEC   analyze random sets instead of reading input; SPEC is key=value,... from sets, seed,\n");
+    fprintf(out, "                        n, u, tmin, tmax, g (period granularity), dmin, dmax (deadline/period) and discard\n");
+    fprintf(out, "  -W, --write-sets      write the generated sets in the input format rather than analyzing them\n");
+    fprintf(out, "  -B, --write-binary F  convert the input (or generated) sets to the binary set file F rather than analyzing\n");
+    fprintf(out, "                        them, keeping the LO WCETs; a set file given to -f is recognized and analyzed in place\n");
+    fprintf(out, "  -h, --help            show this help\n\n");
+    fprintf(out, "Each input line is one task set: [label:] T1,C1[/CH1][,D1[,J1[,B1]]] T2,C2[/CH2][,D2[,J2[,B2]]] ...\n");
+    fprintf(out, "with the release jitter J and blocking B (both default 0) used by ct-o, and the HI criticality WCET CH of a\n");
+    fprintf(out, "HI criticality service used by amc-rtb and amc-max (the other tests take C)\n\n");
+    fprintf(out, "Tests:\n");
+    for(idx=0; idx < NUM_BATCH_TESTS; idx++)
+        fprintf(out, "  %-8s %s\n", batch_tests[idx].name, batch_tests[idx].description);
+}
+
+// The kernel of the batch test with the given name, or NULL if there is none (or it has no common signature kernel, as ct-o and
+// the global tests); used by the other drivers to share the test names
+feasibility_test_fn batch_find_test(const char *name)
+{
+    int idx;
+
+    for(idx=0; idx < NUM_BATCH_TESTS; idx++)
+        if(strcmp(name, batch_tests[idx].name) == 0)
+            return batch_tests[idx].fn;
+    return NULL;
+}
+
+// Turn a comma separated list of test names into the list of indexes into batch_tests[]
+static int batch_select_tests(const char *list, int selected[], int *numSelected)
+{
+    char name[32];
+    const char *p = list;
+    int idx, len;
+
+    *numSelected = 0;
+
+    if(strcmp(list, "all") == 0)
+    {
+        for(idx=0; idx < NUM_BATCH_TESTS; idx++)
+            selected[(*numSelected)++] = idx;
+        return TRUE;
+    }
+
+    while(*p)
+    {
+        len = strcspn(p, ",");
+        if(len == 0 || len >= (int)sizeof(name))
+            return FALSE;
+        memcpy(name, p, len);
+        name[len] = '\0';
+
+        for(idx=0; idx < NUM_BATCH_TESTS; idx++)
+            if(strcmp(name, batch_tests[idx].name) == 0)
+                break;
+        if(idx == NUM_BATCH_TESTS || *numSelected == NUM_BATCH_TESTS)
+            return FALSE;
+        selected[(*numSelected)++] = idx;
+
+        p += len;
+        if(*p == ',')
+            p++;
+    }
+
+    return (*numSelected > 0);
+}
+
+static int batch_set_reserve(batch_set_t *set, U32_T needed)
+{
+    U32_T newCapacity;
+    U32_T *p;
+    U64_T *r;
+
+    if(needed <= set->capacity)
+        return TRUE;
+
+    newCapacity = set->capacity ? set->capacity : 16;
+    while(newCapacity < needed)
+        newCapacity *= 2;
+
+    if((p = realloc(set->period, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->period = p;
+    if((p = realloc(set->wcet, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->wcet = p;
+    if((p = realloc(set->deadline, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->deadline = p;
+    if((p = realloc(set->jitter, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->jitter = p;
+    if((p = realloc(set->blocking, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->blocking = p;
+    if((p = realloc(set->wcetHi, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->wcetHi = p;
+    if((p = realloc(set->scratch, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->scratch = p;
+    if((r = realloc(set->response, newCapacity * sizeof(U64_T))) == NULL) return FALSE;
+    set->response = r;
+    if((p = realloc(set->order, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->order = p;
+    if((p = realloc(set->maxWcet, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->maxWcet = p;
+    if((p = realloc(set->minPeriod, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    set->minPeriod = p;
+
+    set->capacity = newCapacity;
+    return TRUE;
+}
+
+void batch_set_free(batch_set_t *set)
+{
+    free(set->period);
+    free(set->wcet);
+    free(set->deadline);
+    free(set->jitter);
+    free(set->blocking);
+    free(set->wcetHi);
+    free(set->scratch);
+    free(set->response);
+    free(set->order);
+    free(set->maxWcet);
+    free(set->minPeriod);
+    memset(set, 0, sizeof(*set));
+}
+
+static int parse_u32(char **p, U32_T *value)
+{
+    unsigned long v;
+    char *end;
+
+    if(!isdigit((unsigned char)**p))
+        return FALSE;
+
+    errno = 0;
+    v = strtoul(*p, &end, 10);
+    if(errno || v > UINT_MAX)
+        return FALSE;
+
+    *value = (U32_T)v;
+    *p = end;
+    return TRUE;
+}
+
+/* Parse one input line into set.  Returns 1 when a task set was parsed, 0 for blank and comment lines and -1 (with error set)
+ * for a malformed line.  The line is not modified.
+ */
+int batch_parse_line(char *line, batch_set_t *set, const char **error)
+{
+    char *p = line, *colon;
+    U32_T T, C, CH, D, J, B;
+    size_t len;
+
+    set->numServices = 0;
+    set->label[0] = '\0';
+
+    while(isspace((unsigned char)*p)) p++;
+    if(*p == '\0' || *p == '#')
+        return 0;
+
+    // optional "label:" prefix
+    if((colon = strchr(p, ':')) != NULL)
+    {
+        len = colon - p;
+        while(len > 0 && isspace((unsigned char)p[len-1])) len--;
+        if(len >= BATCH_LABEL_MAX)
+            len = BATCH_LABEL_MAX - 1;
+        memcpy(set->label, p, len);
+        set->label[len] = '\0';
+        p = colon + 1;
+    }
+
+    while(1)
+    {
+        while(isspace((unsigned char)*p)) p++;
+        if(*p == '\0' || *p == '#')
+            break;
+
+        if(!parse_u32(&p, &T) || *p++ != ',' || !parse_u32(&p, &C))
+        {
+            *error = "expected period,wcet[/wcet_hi][,deadline[,jitter[,blocking]]]";
+            return -1;
+        }
+        D = T;
+        CH = J = B = 0;
+        if(*p == '/')
+        {
+            p++;
+            if(!parse_u32(&p, &CH) || CH < C || CH == 0)
+            {
+                *error = "bad HI criticality wcet";
+                return -1;
+            }
+        }
+        if(*p == ',')
+        {
+            p++;
+            if(!parse_u32(&p, &D))
+            {
+                *error = "bad deadline";
+                return -1;
+            }
+        }
+        if(*p == ',')
+        {
+            p++;
+            if(!parse_u32(&p, &J))
+            {
+                *error = "bad jitter";
+                return -1;
+            }
+        }
+        if(*p == ',')
+        {
+            p++;
+            if(!parse_u32(&p, &B))
+            {
+                *error = "bad blocking";
+                return -1;
+            }
+        }
+        if(*p != '\0' && !isspace((unsigned char)*p) && *p != '#')
+        {
+            *error = "unexpected character after service";
+            return -1;
+        }
+        if(T == 0 || D == 0)
+        {
+            *error = "period and deadline must be non-zero";
+            return -1;
+        }
+
+        if(!batch_set_reserve(set, set->numServices + 1))
+        {
+            *error = "out of memory";
+            return -1;
+        }
+        set->period[set->numServices] = T;
+        set->wcet[set->numServices] = C;
+        set->deadline[set->numServices] = D;
+        set->jitter[set->numServices] = J;
+        set->blocking[set->numServices] = B;
+        set->wcetHi[set->numServices] = CH;
+        set->numServices++;
+    }
+
+    if(set->numServices == 0)
+    {
+        *error = "no services";
+        return -1;
+    }
+
+    return 1;
+}
+
+// CSV fields only need quoting when they contain a separator, quote or line break
+static void print_csv_string(FILE *out, const char *str)
+{
+    if(strpbrk(str, ",\"\r\n") == NULL)
+    {
+        fputs(str, out);
+        return;
+    }
+    fputc('"', out);
+    for(; *str; str++)
+    {
+        if(*str == '"')
+            fputc('"', out);
+        fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+static void print_json_string(FILE *out, const char *str)
+{
+    fputc('"', out);
+    for(; *str; str++)
+    {
+        if(*str == '"' || *str == '\\')
+            fprintf(out, "\\%c", *str);
+        else if((unsigned char)*str < 0x20)
+            fprintf(out, "\\u%04x", *str);
+        else
+            fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+static void batch_print_header(FILE *out, int format, const int selected[], int numSelected, int responseTimes, int simStats,
+                               int profile, int partitioned, int margins, int server)
+{
+    int idx;
+
+    if(format != FORMAT_CSV)
+        return;
+
+    fprintf(out, "set,label,n,U");
+    for(idx=0; idx < numSelected; idx++)
+        fprintf(out, ",%s", batch_tests[selected[idx]].name);
+    if(responseTimes)
+        fprintf(out, ",R");
+    if(simStats)
+        for(idx=0; idx < numSelected; idx++)
+            if(batch_tests[selected[idx]].simPolicy >= 0)
+                fprintf(out, ",%s_misses,%s_preemptions,%s_switches,%s_overhead", batch_tests[selected[idx]].name,
+                        batch_tests[selected[idx]].name, batch_tests[selected[idx]].name, batch_tests[selected[idx]].name);
+    for(idx=0; profile && idx < numSelected; idx++)
+        fprintf(out, ",%s_iter,%s_points,%s_div,%s_ns,%s_cycles", batch_tests[selected[idx]].name,
+                batch_tests[selected[idx]].name, batch_tests[selected[idx]].name, batch_tests[selected[idx]].name,
+                batch_tests[selected[idx]].name);
+    if(partitioned)
+        fprintf(out, ",part,cores,map,coreU");
+    if(margins)
+        fprintf(out, ",scale,maxC,minT");
+    if(server)
+        fprintf(out, ",budget,serverR,aperiodicR");
+    fprintf(out, "\n");
+}
+
+// One response time, with an unknown or unbounded one shown as the given placeholder
+static void print_response_time(FILE *out, U64_T response, const char *unknown)
+{
+    if(response == RTA_RESPONSE_UNKNOWN)
+        fputs(unknown, out);
+    else
+        fprintf(out, "%llu", response);
+}
+
+// Response times as a separated list, with unknown or unbounded entries shown as the given placeholder
+static void print_response_times(FILE *out, const batch_set_t *set, char separator, const char *unknown)
+{
+    U32_T idx;
+
+    for(idx=0; idx < set->numServices; idx++)
+    {
+        if(idx)
+            fputc(separator, out);
+        print_response_time(out, set->response[idx], unknown);
+    }
+}
+
+// Partition core map and per-core utilizations as separated lists, with unplaced services shown as the given placeholder
+static void print_core_map(FILE *out, const partition_t *part, char separator, const char *unassigned)
+{
+    U32_T idx;
+
+    for(idx=0; idx < part->numServices; idx++)
+    {
+        if(idx)
+            fputc(separator, out);
+        if(part->core[idx] == PARTITION_UNASSIGNED)
+            fputs(unassigned, out);
+        else
+            fprintf(out, "%u", part->core[idx]);
+    }
+}
+
+static void print_core_utilization(FILE *out, const partition_t *part, char separator)
+{
+    U32_T idx;
+
+    for(idx=0; idx < part->numCores; idx++)
+    {
+        if(idx)
+            fputc(separator, out);
+        fprintf(out, "%.4f", part->utilization[idx]);
+    }
+}
+
+// Per-service sensitivity limits as a separated list
+static void print_limits(FILE *out, const batch_set_t *set, const U32_T limits[], char separator)
+{
+    U32_T idx;
+
+    for(idx=0; idx < set->numServices; idx++)
+    {
+        if(idx)
+            fputc(separator, out);
+        fprintf(out, "%u", limits[idx]);
+    }
+}
+
+static void batch_print_result(FILE *out, int format, unsigned long setNo, const batch_set_t *set, double utility_sum,
+                               const int selected[], const int results[], int numSelected, int responseTimes,
+                               const sim_result_t simResults[], const batch_profile_t profile[], const partition_t *part,
+                               int margins, const server_result_t *server)
+{
+    const batch_profile_t *pr;
+    const sim_result_t *sr;
+    int idx;
+
+    switch(format)
+    {
+        case FORMAT_CSV:
+            fprintf(out, "%lu,", setNo);
+            print_csv_string(out, set->label);
+            fprintf(out, ",%u,%.6f", set->numServices, utility_sum);
+            for(idx=0; idx < numSelected; idx++)
+                fprintf(out, ",%d", results[idx]);
+            if(responseTimes)
+            {
+                fputc(',', out);
+                print_response_times(out, set, ';', "");
+            }
+            for(idx=0; simResults && idx < numSelected; idx++)
+            {
+                sr = &simResults[idx];
+                if(batch_tests[selected[idx]].simPolicy >= 0)
+                    fprintf(out, ",%llu,%llu,%llu,%llu", sr->deadlineMisses, sr->preemptions, sr->contextSwitches,
+                            sr->overheadTime);
+            }
+            for(idx=0; profile && idx < numSelected; idx++)
+            {
+                pr = &profile[idx];
+                fprintf(out, ",%llu,%llu,%llu,%llu,%llu", pr->iterations, pr->points, pr->divisions, pr->ns, pr->cycles);
+            }
+            if(part)
+            {
+                fprintf(out, ",%d,%u,", part->numUnassigned == 0, part->numCores);
+                print_core_map(out, part, ';', "");
+                fputc(',', out);
+                print_core_utilization(out, part, ';');
+            }
+            if(margins)
+            {
+                fprintf(out, ",%.6f,", set->scale);
+                if(set->limitsValid)
+                {
+                    print_limits(out, set, set->maxWcet, ';');
+                    fputc(',', out);
+                    print_limits(out, set, set->minPeriod, ';');
+                }
+                else
+                    fputc(',', out);
+            }
+            if(server)
+            {
+                fprintf(out, ",%u,", server->budget);
+                print_response_time(out, server->response, "");
+                fputc(',', out);
+                print_response_time(out, server->aperiodic, "");
+            }
+            break;
+
+        case FORMAT_JSONL:
+            fprintf(out, "{\"set\":%lu,\"label\":", setNo);
+            print_json_string(out, set->label);
+            fprintf(out, ",\"n\":%u,\"U\":%.6f", set->numServices, utility_sum);
+            for(idx=0; idx < numSelected; idx++)
+                fprintf(out, ",\"%s\":%s", batch_tests[selected[idx]].name, results[idx] ? "true" : "false");
+            if(responseTimes)
+            {
+                fprintf(out, ",\"R\":[");
+                print_response_times(out, set, ',', "null");
+                fputc(']', out);
+            }
+            for(idx=0; simResults && idx < numSelected; idx++)
+            {
+                sr = &simResults[idx];
+                if(batch_tests[selected[idx]].simPolicy >= 0)
+                    fprintf(out, ",\"%s_stats\":{\"misses\":%llu,\"preemptions\":%llu,\"switches\":%llu,\"overhead\":%llu,"
+                            "\"jobs\":%llu,\"busy\":%llu,\"horizon\":%llu}", batch_tests[selected[idx]].name,
+                            sr->deadlineMisses, sr->preemptions, sr->contextSwitches, sr->overheadTime, sr->jobsReleased,
+                            sr->busyTime, sr->horizon);
+            }
+            for(idx=0; profile && idx < numSelected; idx++)
+            {
+                pr = &profile[idx];
+                fprintf(out, ",\"%s_profile\":{\"iter\":%llu,\"points\":%llu,\"div\":%llu,\"ns\":%llu,\"cycles\":%llu}",
+                        batch_tests[selected[idx]].name, pr->iterations, pr->points, pr->divisions, pr->ns, pr->cycles);
+            }
+            if(part)
+            {
+                fprintf(out, ",\"part\":%s,\"cores\":%u,\"map\":[", part->numUnassigned ? "false" : "true", part->numCores);
+                print_core_map(out, part, ',', "null");
+                fprintf(out, "],\"coreU\":[");
+                print_core_utilization(out, part, ',');
+                fputc(']', out);
+            }
+            if(margins)
+            {
+                // JSON has no infinity, the factor of a set without any WCET to scale
+                if(isinf(set->scale))
+                    fprintf(out, ",\"scale\":null");
+                else
+                    fprintf(out, ",\"scale\":%.6f", set->scale);
+                if(set->limitsValid)
+                {
+                    fprintf(out, ",\"maxC\":[");
+                    print_limits(out, set, set->maxWcet, ',');
+                    fprintf(out, "],\"minT\":[");
+                    print_limits(out, set, set->minPeriod, ',');
+                    fputc(']', out);
+                }
+                else
+                    fprintf(out, ",\"maxC\":null,\"minT\":null");
+            }
+            if(server)
+            {
+                fprintf(out, ",\"server\":{\"budget\":%u,\"response\":", server->budget);
+                print_response_time(out, server->response, "null");
+                fprintf(out, ",\"aperiodic\":");
+                print_response_time(out, server->aperiodic, "null");
+                fputc('}', out);
+            }
+            fprintf(out, "}");
+            break;
+
+        default:
+            if(set->label[0])
+                fprintf(out, "%s", set->label);
+            else
+                fprintf(out, "%lu", setNo);
+            fprintf(out, " n=%u U=%.4f", set->numServices, utility_sum);
+            for(idx=0; idx < numSelected; idx++)
+                fprintf(out, " %s=%d", batch_tests[selected[idx]].name, results[idx]);
+            if(responseTimes)
+            {
+                fprintf(out, " R=");
+                print_response_times(out, set, ',', "-");
+            }
+            for(idx=0; simResults && idx < numSelected; idx++)
+            {
+                sr = &simResults[idx];
+                if(batch_tests[selected[idx]].simPolicy >= 0)
+                    fprintf(out, " %s:misses=%llu,preemptions=%llu,switches=%llu,overhead=%llu", batch_tests[selected[idx]].name,
+                            sr->deadlineMisses, sr->preemptions, sr->contextSwitches, sr->overheadTime);
+            }
+            for(idx=0; profile && idx < numSelected; idx++)
+            {
+                pr = &profile[idx];
+                fprintf(out, " %s:iter=%llu,points=%llu,div=%llu,ns=%llu,cycles=%llu", batch_tests[selected[idx]].name,
+                        pr->iterations, pr->points, pr->divisions, pr->ns, pr->cycles);
+            }
+            if(part)
+            {
+                fprintf(out, " part=%d cores=%u map=", part->numUnassigned == 0, part->numCores);
+                print_core_map(out, part, ',', "-");
+                fprintf(out, " coreU=");
+                print_core_utilization(out, part, ',');
+            }
+            if(margins)
+            {
+                fprintf(out, " scale=%.6f", set->scale);
+                if(set->limitsValid)
+                {
+                    fprintf(out, " maxC=");
+                    print_limits(out, set, set->maxWcet, ',');
+                    fprintf(out, " minT=");
+                    print_limits(out, set, set->minPeriod, ',');
+                }
+            }
+            if(server)
+            {
+                fprintf(out, " budget=%u serverR=", server->budget);
+                print_response_time(out, server->response, "-");
+                fprintf(out, " aperiodicR=");
+                print_response_time(out, server->aperiodic, "-");
+            }
+            break;
+    }
+    fprintf(out, "\n");
+}
+
+// Options that apply to every task set of a run
+typedef struct
+{
+    int selected[NUM_BATCH_TESTS];
+    int numSelected;
+    int format;
+    int responseTimes;
+    int rtaFlags;
+    int simStats;
+    int profile;
+    int priorityPolicy;     // -1 to take the services as listed
+    int partitioned;
+    int heuristic;
+    int margins;
+    U32_T switchCost;       // context switch cost for ct-o
+    sim_options_t sim;      // tie breaking, LLF laxity quantum and switch cost for the sim-* tests
+    U32_T globalCores;      // cores for g-fp and g-edf
+    U32_T numCores;         // 0 for the fewest cores that work
+    const gen_params_t *gen;    // generate the sets rather than reading them
+    const server_params_t *server;  // the aperiodic server to size for each set, NULL for none
+    const setfile_t *file;      // or analyze the sets of a mapped set file in place
+    int writeSets;          // write the sets out instead of the results
+    setfile_writer_t *writer;   // or convert them to a set file (on one thread, in order)
+} batch_options_t;
+
+// Where each piece of a parallel run ended up in its worker's output buffer
+typedef struct
+{
+    U64_T begin;
+    U32_T worker;
+    size_t offset;
+    size_t length;
+} batch_chunk_t;
+
+// Working state of one thread: buffers for the set being analyzed and the results, which are only merged at the end
+typedef struct
+{
+    batch_set_t set;
+    feasibility_context_t ctx;  // the set-wide values of the set being analyzed
+    partition_t part;
+    unsigned long numFeasible[NUM_BATCH_TESTS];
+    U64_T tierDecided[TIER_COUNT];  // sets the tiered test decided by each tier
+    batch_time_profile_t times[NUM_BATCH_TESTS];    // with -P
+    unsigned long numErrors;    // sets the generator gave up on
+    int failed;
+    FILE *out;              // parallel runs format their results into a memory stream...
+    char *buf;
+    size_t size;
+    batch_chunk_t *chunks;  // ...and record which sets each piece holds
+    U32_T numChunks;
+    U32_T chunkCapacity;
+} batch_worker_t;
+
+static inline U64_T batch_clock_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (U64_T)ts.tv_sec * 1000000000ULL + (U64_T)ts.tv_nsec;
+}
+
+static inline U64_T batch_cycles(void)
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline U32_T batch_time_bucket(U64_T ns)
+{
+    U32_T msb;
+
+    if(ns < 8)
+        return (U32_T)ns;
+    msb = 63 - __builtin_clzll(ns);
+    return 4*msb + (U32_T)((ns >> (msb - 2)) & 3);
+}
+
+// The shortest time that falls in a bucket
+static U64_T batch_bucket_ns(U32_T bucket)
+{
+    if(bucket < 8)
+        return bucket;
+    return (U64_T)(4 + bucket % 4) << (bucket / 4 - 2);
+}
+
+// Finish the profile of test idx on a set from the counters and clocks read before it ran, and add it to the worker's times
+static void batch_profile_end(batch_worker_t *w, int idx, const feasibility_counters_t *before, U64_T startNs,
+                              U64_T startCycles, unsigned long setNo, batch_profile_t *pr)
+{
+    batch_time_profile_t *tp = &w->times[idx];
+
+    pr->ns = batch_clock_ns() - startNs;
+    pr->cycles = batch_cycles() - startCycles;
+    pr->iterations = feasibility_counters.iterations - before->iterations;
+    pr->points = feasibility_counters.points - before->points;
+    pr->divisions = feasibility_counters.divisions - before->divisions;
+
+    tp->histogram[batch_time_bucket(pr->ns)]++;
+    if(pr->ns >= tp->maxNs)
+    {
+        tp->maxNs = pr->ns;
+        tp->maxSetNo = setNo;
+        strcpy(tp->maxLabel, w->set.label);
+    }
+}
+
+static void print_duration(FILE *out, U64_T ns)
+{
+    if(ns < 1000)
+        fprintf(out, "%llu ns", ns);
+    else if(ns < 1000000)
+        fprintf(out, "%.1f us", ns / 1e3);
+    else if(ns < 1000000000)
+        fprintf(out, "%.1f ms", ns / 1e6);
+    else
+        fprintf(out, "%.2f s", ns / 1e9);
+}
+
+/* The -P summary of test idx over every worker's sets: the median, 99th percentile (both to the lower end of their quarter
+ * octave bucket) and the slowest set, then the number of sets per octave of time.
+ */
+static void batch_print_times(FILE *out, const batch_worker_t workers[], unsigned long numWorkers, int idx)
+{
+    U64_T histogram[BATCH_TIME_BUCKETS] = {0}, total = 0, seen = 0, median = 0, p99 = 0, octave;
+    const batch_time_profile_t *slowest = &workers[0].times[idx];
+    unsigned long w;
+    U32_T b;
+
+    for(w=0; w < numWorkers; w++)
+    {
+        for(b=0; b < BATCH_TIME_BUCKETS; b++)
+            histogram[b] += workers[w].times[idx].histogram[b];
+        if(workers[w].times[idx].maxNs > slowest->maxNs)
+            slowest = &workers[w].times[idx];
+    }
+    for(b=0; b < BATCH_TIME_BUCKETS; b++)
+        total += histogram[b];
+    if(total == 0)
+        return;
+
+    for(b=0; b < BATCH_TIME_BUCKETS; b++)
+    {
+        if(seen < (total + 1) / 2 && seen + histogram[b] >= (total + 1) / 2)
+            median = batch_bucket_ns(b);
+        if(seen < total - total / 100 && seen + histogram[b] >= total - total / 100)
+            p99 = batch_bucket_ns(b);
+        seen += histogram[b];
+    }
+
+    fprintf(out, "  %-8s time per set: median ", "");
+    print_duration(out, median);
+    fprintf(out, ", p99 ");
+    print_duration(out, p99);
+    fprintf(out, ", max ");
+    print_duration(out, slowest->maxNs);
+    if(slowest->maxLabel[0])
+        fprintf(out, " (set %s", slowest->maxLabel);
+    else
+        fprintf(out, " (set %lu", slowest->maxSetNo);
+    if(median)
+        fprintf(out, ", %.0fx the median", (double)slowest->maxNs / (double)median);
+    fprintf(out, ")\n  %-8s sets by time:", "");
+
+    // octaves from 8 ns up, the buckets below 8 ns folded into the first
+    for(b=0, octave=0; b < BATCH_TIME_BUCKETS; b++)
+    {
+        octave += histogram[b];
+        if(b >= 12 && b % 4 == 3)
+        {
+            if(octave)
+            {
+                fputc(' ', out);
+                print_duration(out, batch_bucket_ns(b - 3));
+                fprintf(out, "+ %llu", octave);
+            }
+            octave = 0;
+        }
+    }
+    fputc('\n', out);
+}
+
+// Reorder column to the priority order, before priority_permute uses up order
+static void batch_permute_column(U32_T numServices, const U32_T order[], U32_T column[], U32_T scratch[])
+{
+    U32_T idx;
+
+    for(idx=0; idx < numServices; idx++)
+        scratch[idx] = column[order[idx]];
+    memcpy(column, scratch, numServices * sizeof(U32_T));
+}
+
+/* Analyze one task set and write its result line to out.  set is reordered in place when a priority policy is given.  Returns
+ * FALSE if memory ran out.
+ */
+static int batch_run_set(const batch_options_t *opts, batch_worker_t *w, unsigned long setNo, FILE *out)
+{
+    batch_set_t *set = &w->set;
+    sim_result_t simResults[NUM_BATCH_TESTS];
+    batch_profile_t profile[NUM_BATCH_TESTS];
+    server_result_t serverResult;
+    feasibility_counters_t before = {0};
+    U64_T startNs = 0, startCycles = 0;
+    int results[NUM_BATCH_TESTS], idx, rc;
+    rta_overheads_t overheads = {set->jitter, set->blocking, opts->switchCost};
+    const batch_test_t *test;
+    tiered_counters_t tiers = tiered_counters;
+    double utility_sum;
+
+    // a write error is remembered by the writer and reported when the file is closed
+    if(opts->writer)
+    {
+        setfile_append(opts->writer, set->label, set->numServices, set->period, set->wcet, set->deadline, set->jitter,
+                       set->blocking);
+        return TRUE;
+    }
+
+    if(opts->writeSets)
+    {
+        fprintf(out, "%s:", set->label);
+        for(idx=0; idx < (int)set->numServices; idx++)
+            fprintf(out, " %u,%u,%u", set->period[idx], set->wcet[idx], set->deadline[idx]);
+        fputc('\n', out);
+        return TRUE;
+    }
+
+    // the tests all take the services in array order, so apply the priority order to the arrays themselves
+    if(opts->priorityPolicy >= 0)
+    {
+        priority_order(set->numServices, set->period, set->wcet, set->deadline, opts->priorityPolicy, set->order);
+        batch_permute_column(set->numServices, set->order, set->jitter, set->scratch);
+        batch_permute_column(set->numServices, set->order, set->blocking, set->scratch);
+        batch_permute_column(set->numServices, set->order, set->wcetHi, set->scratch);
+        priority_permute(set->numServices, set->order, set->period, set->wcet, set->deadline);
+    }
+
+    // the tests share the utilization and hyperperiod of the set through its context
+    context_bind(&w->ctx, set->numServices, set->period, set->wcet, set->deadline);
+    utility_sum = context_utilization(&w->ctx);
+
+    for(idx=0; idx < opts->numSelected; idx++)
+    {
+        test = &batch_tests[opts->selected[idx]];
+        if(opts->profile)
+        {
+            before = feasibility_counters;
+            startCycles = batch_cycles();
+            startNs = batch_clock_ns();
+        }
+
+        if(test->simPolicy >= 0)
+            results[idx] = (sim_run_options(set->numServices, set->period, set->wcet, set->deadline, test->simPolicy,
+                                            context_hyperperiod(&w->ctx), &opts->sim,
+                                            opts->simStats ? &simResults[idx] : NULL) == TRUE);
+        else if(test->contextFn)
+            results[idx] = (test->contextFn(&w->ctx) == TRUE);
+        else if(test->special == BATCH_SPECIAL_OVERHEADS)
+            results[idx] = (rta_response_times_overheads(set->numServices, set->period, set->wcet, set->deadline, &overheads,
+                                                         NULL, RTA_STOP_ON_MISS) == TRUE);
+        else if(test->special == BATCH_SPECIAL_GLOBAL_FP)
+            results[idx] = (global_fp_response_times(set->numServices, opts->globalCores, set->period, set->wcet,
+                                                     set->deadline, NULL) == TRUE);
+        else if(test->special == BATCH_SPECIAL_GLOBAL_EDF)
+            results[idx] = (global_edf_response_times(set->numServices, opts->globalCores, set->period, set->wcet,
+                                                      set->deadline, NULL) == TRUE);
+        else if(test->special == BATCH_SPECIAL_AMC_RTB)
+            results[idx] = (amc_rtb_response_times(set->numServices, set->period, set->wcet, set->wcetHi, set->deadline,
+                                                   NULL, NULL) == TRUE);
+        else if(test->special == BATCH_SPECIAL_AMC_MAX)
+            results[idx] = (amc_max_response_times(set->numServices, set->period, set->wcet, set->wcetHi, set->deadline,
+                                                   NULL, NULL) == TRUE);
+        else
+            results[idx] = (test->fn(set->numServices, set->period, set->wcet, set->deadline) == TRUE);
+
+        if(opts->profile)
+            batch_profile_end(w, idx, &before, startNs, startCycles, setNo, &profile[idx]);
+        w->numFeasible[idx] += results[idx];
+    }
+    for(idx=0; idx < TIER_COUNT; idx++)
+        w->tierDecided[idx] += tiered_counters.decided[idx] - tiers.decided[idx];
+
+    if(opts->responseTimes)
+        rta_response_times(set->numServices, set->period, set->wcet, set->deadline, set->response, opts->rtaFlags);
+
+    if(opts->partitioned)
+    {
+        if(opts->numCores)
+            rc = partition_services(&w->part, set->numServices, set->period, set->wcet, set->deadline, opts->numCores,
+                                    opts->heuristic);
+        else
+            rc = partition_min_cores(&w->part, set->numServices, set->period, set->wcet, set->deadline, opts->heuristic);
+        if(rc < 0)
+            return FALSE;
+    }
+
+    if(opts->margins)
+    {
+        if((rc = sensitivity_wcet_scale(set->numServices, set->period, set->wcet, set->deadline, &set->scale)) < 0 ||
+           (rc && (sensitivity_wcet_limits(set->numServices, set->period, set->wcet, set->deadline, set->maxWcet) < 0 ||
+                   sensitivity_period_limits(set->numServices, set->period, set->wcet, set->deadline, set->minPeriod) < 0)))
+            return FALSE;
+        set->limitsValid = rc;
+    }
+
+    if(opts->server && server_max_budget(set->numServices, set->period, set->wcet, set->deadline, opts->server,
+                                         &serverResult) < 0)
+        return FALSE;
+
+    batch_print_result(out, opts->format, setNo, set, utility_sum, opts->selected, results, opts->numSelected,
+                       opts->responseTimes, opts->simStats ? simResults : NULL, opts->profile ? profile : NULL,
+                       opts->partitioned ? &w->part : NULL, opts->margins, opts->server ? &serverResult : NULL);
+    return TRUE;
+}
+
+// Task sets read ahead for a parallel run, stored column-wise with the tasks of set i at offset[i]..offset[i+1]-1
+typedef struct
+{
+    U32_T numSets;
+    U32_T setCapacity;
+    U64_T taskCapacity;
+    U64_T *offset;
+    char (*label)[BATCH_LABEL_MAX];
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *jitter;
+    U32_T *blocking;
+    U32_T *wcetHi;
+} batch_corpus_t;
+
+// Sets per parallel round, which bounds the memory held for a stream of any length
+#define BATCH_WINDOW_SETS (1U << 16)
+
+// Sets per piece of work taken by a worker; small enough that a slow set only holds up a few others
+#define BATCH_GRAIN 16
+
+static int batch_corpus_append(batch_corpus_t *corpus, const batch_set_t *set)
+{
+    U64_T first = corpus->numSets ? corpus->offset[corpus->numSets] : 0, newCapacity;
+    U64_T *o;
+    U32_T *p;
+    char (*l)[BATCH_LABEL_MAX];
+
+    if(corpus->numSets == corpus->setCapacity)
+    {
+        newCapacity = corpus->setCapacity ? 2 * corpus->setCapacity : 1024;
+        if((o = realloc(corpus->offset, (newCapacity + 1) * sizeof(U64_T))) == NULL) return FALSE;
+        corpus->offset = o;
+        if((l = realloc(corpus->label, newCapacity * sizeof(*l))) == NULL) return FALSE;
+        corpus->label = l;
+        corpus->setCapacity = newCapacity;
+    }
+
+    if(first + set->numServices > corpus->taskCapacity)
+    {
+        newCapacity = corpus->taskCapacity ? corpus->taskCapacity : 16384;
+        while(newCapacity < first + set->numServices)
+            newCapacity *= 2;
+        if((p = realloc(corpus->period, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->period = p;
+        if((p = realloc(corpus->wcet, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->wcet = p;
+        if((p = realloc(corpus->deadline, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->deadline = p;
+        if((p = realloc(corpus->jitter, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->jitter = p;
+        if((p = realloc(corpus->blocking, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->blocking = p;
+        if((p = realloc(corpus->wcetHi, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+        corpus->wcetHi = p;
+        corpus->taskCapacity = newCapacity;
+    }
+
+    memcpy(&corpus->period[first], set->period, set->numServices * sizeof(U32_T));
+    memcpy(&corpus->wcet[first], set->wcet, set->numServices * sizeof(U32_T));
+    memcpy(&corpus->deadline[first], set->deadline, set->numServices * sizeof(U32_T));
+    memcpy(&corpus->jitter[first], set->jitter, set->numServices * sizeof(U32_T));
+    memcpy(&corpus->blocking[first], set->blocking, set->numServices * sizeof(U32_T));
+    memcpy(&corpus->wcetHi[first], set->wcetHi, set->numServices * sizeof(U32_T));
+    memcpy(corpus->label[corpus->numSets], set->label, BATCH_LABEL_MAX);
+    corpus->offset[corpus->numSets] = first;
+    corpus->offset[++corpus->numSets] = first + set->numServices;
+    return TRUE;
+}
+
+static int batch_corpus_load(const batch_corpus_t *corpus, U32_T idx, batch_set_t *set)
+{
+    U64_T first = corpus->offset[idx];
+    U32_T n = (U32_T)(corpus->offset[idx+1] - first);
+
+    if(!batch_set_reserve(set, n))
+        return FALSE;
+
+    memcpy(set->period, &corpus->period[first], n * sizeof(U32_T));
+    memcpy(set->wcet, &corpus->wcet[first], n * sizeof(U32_T));
+    memcpy(set->deadline, &corpus->deadline[first], n * sizeof(U32_T));
+    memcpy(set->jitter, &corpus->jitter[first], n * sizeof(U32_T));
+    memcpy(set->blocking, &corpus->blocking[first], n * sizeof(U32_T));
+    memcpy(set->wcetHi, &corpus->wcetHi[first], n * sizeof(U32_T));
+    memcpy(set->label, corpus->label[idx], BATCH_LABEL_MAX);
+    set->numServices = n;
+    return TRUE;
+}
+
+/* Generate set number setNo of the run (counting from 1) into the worker's set buffer.  Returns 1 when the set was generated, 0
+ * when the generator gave up on it and -1 if memory ran out.
+ */
+static int batch_generate_set(const gen_params_t *gen, unsigned long setNo, batch_set_t *set)
+{
+    if(!batch_set_reserve(set, gen->numServices))
+        return -1;
+
+    snprintf(set->label, BATCH_LABEL_MAX, "g%lu", setNo - 1);
+    set->numServices = gen->numServices;
+    memset(set->jitter, 0, set->numServices * sizeof(U32_T));
+    memset(set->blocking, 0, set->numServices * sizeof(U32_T));
+    memset(set->wcetHi, 0, set->numServices * sizeof(U32_T));
+    return gen_task_set(gen, setNo - 1, set->period, set->wcet, set->deadline) ? 1 : 0;
+}
+
+/* Analyze set number setNo of the mapped set file in place: the worker's set borrows the file's columns for the analysis rather
+ * than copying them, and only the label is copied.  The mapping is private, so a priority reordering stays in memory.  Returns
+ * FALSE if memory ran out.
+ */
+static int batch_run_file_set(const batch_options_t *opts, batch_worker_t *w, unsigned long setNo, FILE *out)
+{
+    const setfile_t *file = opts->file;
+    batch_set_t *set = &w->set;
+    U32_T *own[5] = {NULL};
+    U64_T first = file->offsets[setNo - 1];
+    U32_T n = (U32_T)(file->offsets[setNo] - first);
+    int ok;
+
+    // the buffers the set keeps for the per-service results, and the overheads of a file that has none; set files hold single
+    // criticality sets
+    if(!batch_set_reserve(set, n))
+        return FALSE;
+    memset(set->wcetHi, 0, n * sizeof(U32_T));
+    if(!file->jitter)
+    {
+        memset(set->jitter, 0, n * sizeof(U32_T));
+        memset(set->blocking, 0, n * sizeof(U32_T));
+    }
+
+    own[0] = set->period; own[1] = set->wcet; own[2] = set->deadline; own[3] = set->jitter; own[4] = set->blocking;
+    set->period = &file->period[first];
+    set->wcet = &file->wcet[first];
+    set->deadline = &file->deadline[first];
+    if(file->jitter)
+    {
+        set->jitter = &file->jitter[first];
+        set->blocking = &file->blocking[first];
+    }
+    snprintf(set->label, BATCH_LABEL_MAX, "%s", setfile_label(file, setNo - 1));
+    set->numServices = n;
+
+    ok = batch_run_set(opts, w, setNo, out);
+
+    set->period = own[0]; set->wcet = own[1]; set->deadline = own[2]; set->jitter = own[3]; set->blocking = own[4];
+    return ok;
+}
+
+static void batch_corpus_free(batch_corpus_t *corpus)
+{
+    free(corpus->offset);
+    free(corpus->label);
+    free(corpus->period);
+    free(corpus->wcet);
+    free(corpus->deadline);
+    free(corpus->jitter);
+    free(corpus->blocking);
+    free(corpus->wcetHi);
+    memset(corpus, 0, sizeof(*corpus));
+}
+
+typedef struct
+{
+    const batch_options_t *opts;
+    const batch_corpus_t *corpus;
+    batch_worker_t *workers;
+    unsigned long firstSetNo;
+} batch_round_t;
+
+static void batch_run_range(void *context, U32_T worker, U64_T begin, U64_T end)
+{
+    batch_round_t *round = context;
+    batch_worker_t *w = &round->workers[worker];
+    batch_chunk_t *c;
+    long start = ftell(w->out);
+    U64_T idx;
+    int rc;
+
+    for(idx=begin; idx < end; idx++)
+    {
+        if(round->opts->gen)
+            rc = batch_generate_set(round->opts->gen, round->firstSetNo + idx, &w->set);
+        else if(round->opts->file)
+            rc = batch_run_file_set(round->opts, w, round->firstSetNo + idx, w->out) ? 2 : -1;
+        else
+            rc = batch_corpus_load(round->corpus, (U32_T)idx, &w->set) ? 1 : -1;
+
+        if(rc == 0)
+        {
+            fprintf(stderr, "set %llu: no utilization split found\n", (U64_T)(round->firstSetNo + idx));
+            w->numErrors++;
+        }
+        else if(rc < 0 || (rc == 1 && !batch_run_set(round->opts, w, round->firstSetNo + idx, w->out)))
+            w->failed = TRUE;
+    }
+
+    if(w->numChunks == w->chunkCapacity)
+    {
+        w->chunkCapacity = w->chunkCapacity ? 2 * w->chunkCapacity : 256;
+        if((c = realloc(w->chunks, w->chunkCapacity * sizeof(batch_chunk_t))) == NULL)
+        {
+            w->failed = TRUE;
+            return;
+        }
+        w->chunks = c;
+    }
+    c = &w->chunks[w->numChunks++];
+    c->begin = begin;
+    c->worker = worker;
+    c->offset = (size_t)start;
+    c->length = (size_t)(ftell(w->out) - start);
+}
+
+static int batch_chunk_compare(const void *a, const void *b)
+{
+    const batch_chunk_t *ca = a, *cb = b;
+
+    return (ca->begin > cb->begin) - (ca->begin < cb->begin);
+}
+
+/* Analyze numSets sets on numWorkers threads, then write the pieces of every worker's output in set order.  The sets come from
+ * the corpus, or from the generator or the mapped set file when there is one.  Returns FALSE if memory ran out.
+ */
+static int batch_run_round(const batch_options_t *opts, const batch_corpus_t *corpus, U32_T numSets, batch_worker_t workers[],
+                           U32_T numWorkers, unsigned long firstSetNo)
+{
+    batch_round_t round = {opts, corpus, workers, firstSetNo};
+    batch_chunk_t *all, *c;
+    U32_T idx, total = 0, k;
+    int ok = TRUE;
+
+    for(idx=0; idx < numWorkers; idx++)
+    {
+        workers[idx].numChunks = 0;
+        if((workers[idx].out = open_memstream(&workers[idx].buf, &workers[idx].size)) == NULL)
+            ok = FALSE;
+    }
+
+    if(ok && !parallel_for(numSets, numWorkers, BATCH_GRAIN, batch_run_range, &round))
+        ok = FALSE;
+
+    for(idx=0; idx < numWorkers; idx++)
+    {
+        if(workers[idx].out)
+            fflush(workers[idx].out);
+        ok = ok && !workers[idx].failed;
+        total += workers[idx].numChunks;
+    }
+
+    if(ok && (all = malloc((total ? total : 1) * sizeof(batch_chunk_t))) != NULL)
+    {
+        for(idx=0, k=0; idx < numWorkers; idx++)
+        {
+            memcpy(&all[k], workers[idx].chunks, workers[idx].numChunks * sizeof(batch_chunk_t));
+            k += workers[idx].numChunks;
+        }
+        qsort(all, total, sizeof(batch_chunk_t), batch_chunk_compare);
+        for(c=all; c < all + total; c++)
+            fwrite(workers[c->worker].buf + c->offset, 1, c->length, stdout);
+        free(all);
+    }
+    else
+        ok = FALSE;
+
+    for(idx=0; idx < numWorkers; idx++)
+    {
+        if(workers[idx].out)
+            fclose(workers[idx].out);
+        workers[idx].out = NULL;
+        free(workers[idx].buf);
+        workers[idx].buf = NULL;
+    }
+
+    return ok;
+}
+
+int batch_main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        {"batch", no_argument,       NULL, 'b'},
+        {"input", required_argument, NULL, 'f'},
+        {"tests", required_argument, NULL, 't'},
+        {"format", required_argument, NULL, 'o'},
+        {"verbosity", required_argument, NULL, 'v'},
+        {"engine", required_argument, NULL, 'e'},
+        {"response-times", no_argument, NULL, 'r'},
+        {"stop-on-miss", no_argument, NULL, 's'},
+        {"sim-stats", no_argument, NULL, 'S'},
+        {"priority", required_argument, NULL, 'p'},
+        {"cores", required_argument, NULL, 'c'},
+        {"heuristic", required_argument, NULL, 'H'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"generate", required_argument, NULL, 'g'},
+        {"server", required_argument, NULL, 'a'},
+        {"write-sets", no_argument, NULL, 'W'},
+        {"write-binary", required_argument, NULL, 'B'},
+        {"margins", no_argument, NULL, 'm'},
+        {"profile", no_argument, NULL, 'P'},
+        {"switch-cost", required_argument, NULL, 'O'},
+        {"tie", required_argument, NULL, 'T'},
+        {"quantum", required_argument, NULL, 'Q'},
+        {"global-cores", required_argument, NULL, 'M'},
+        {"help",  no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    batch_options_t opts = {.format = FORMAT_TEXT, .priorityPolicy = -1, .heuristic = PARTITION_FF,
+                            .globalCores = DEFAULT_GLOBAL_CORES};
+    const char *inputName = NULL, *binaryName = NULL, *testList = DEFAULT_BATCH_TESTS, *error;
+    setfile_writer_t writer;
+    setfile_t file;
+    int opt, idx, rc, verbosity = VERBOSITY_SILENT, ok = TRUE;
+    unsigned long lineNo = 0, numSets = 0, numErrors = 0, numFeasible, value;
+    U64_T tierTotal;
+    unsigned long numWorkers = 1;
+    batch_worker_t *workers;
+    batch_corpus_t corpus = {0};
+    batch_set_t set = {0};
+    gen_params_t gen;
+    server_params_t server;
+    char *line = NULL, *end;
+    size_t lineCap = 0;
+    FILE *in = stdin;
+
+    sim_default_options(&opts.sim);
+    while((opt = getopt_long(argc, argv, "bf:t:o:v:e:p:c:H:j:g:a:O:M:B:T:Q:WrsSmPh", long_options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'b': break;
+            case 'r': opts.responseTimes = TRUE; break;
+            case 's': opts.rtaFlags |= RTA_STOP_ON_MISS; break;
+            case 'S': opts.simStats = TRUE; break;
+            case 'W': opts.writeSets = TRUE; break;
+            case 'B': binaryName = optarg; break;
+            case 'm': opts.margins = TRUE; break;
+            case 'P': opts.profile = TRUE; break;
+            case 'g':
+                gen_default_params(&gen);
+                if(!gen_parse_params(optarg, &gen, &error))
+                {
+                    fprintf(stderr, "%s: %s in \"%s\"\n", argv[0], error, optarg);
+                    return 2;
+                }
+                opts.gen = &gen;
+                break;
+            case 'a':
+                server_default_params(&server);
+                if(!server_parse_params(optarg, &server, &error))
+                {
+                    fprintf(stderr, "%s: %s in \"%s\"\n", argv[0], error, optarg);
+                    return 2;
+                }
+                opts.server = &server;
+                break;
+            case 'f': inputName = optarg; break;
+            case 't': testList = optarg; break;
+            case 'o':
+                if((opts.format = lookup_name(optarg, format_names, sizeof(format_names)/sizeof(format_names[0]))) < 0)
+                {
+                    fprintf(stderr, "%s: unknown format \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'e':
+                if((feasibility_engine = lookup_name(optarg, engine_names, sizeof(engine_names)/sizeof(engine_names[0]))) < 0)
+                {
+                    fprintf(stderr, "%s: unknown engine \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'p':
+                if((opts.priorityPolicy = lookup_name(optarg, priority_policy_names, PRIORITY_OPA+1)) < 0)
+                {
+                    fprintf(stderr, "%s: unknown priority policy \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'T':
+                if((opts.sim.tieBreak = lookup_name(optarg, sim_tie_names, SIM_TIE_DEADLINE+1)) < 0)
+                {
+                    fprintf(stderr, "%s: unknown tie breaking rule \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'c':
+            case 'j':
+            case 'O':
+            case 'M':
+            case 'Q':
+                errno = 0;
+                value = strtoul(optarg, &end, 10);
+                if(errno || end == optarg || *end || value > UINT_MAX || ((opt == 'M' || opt == 'Q') && value == 0))
+                {
+                    fprintf(stderr, "%s: bad %s \"%s\"\n", argv[0], (opt == 'c' || opt == 'M') ? "core count" :
+                            (opt == 'j') ? "job count" : (opt == 'Q') ? "laxity quantum" : "switch cost", optarg);
+                    return 2;
+                }
+                if(opt == 'c')
+                {
+                    opts.numCores = (U32_T)value;
+                    opts.partitioned = TRUE;
+                }
+                else if(opt == 'j')
+                    numWorkers = value ? value : parallel_default_workers();
+                else if(opt == 'M')
+                    opts.globalCores = (U32_T)value;
+                else if(opt == 'Q')
+                    opts.sim.laxityQuantum = value;
+                else
+                    opts.switchCost = opts.sim.switchCost = (U32_T)value;
+                break;
+            case 'H':
+                if((opts.heuristic = lookup_name(optarg, partition_heuristic_names, PARTITION_WF+1)) < 0)
+                {
+                    fprintf(stderr, "%s: unknown partitioning heuristic \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'v':
+                if((verbosity = lookup_name(optarg, verbosity_names, sizeof(verbosity_names)/sizeof(verbosity_names[0]))) < 0)
+                {
+                    fprintf(stderr, "%s: unknown verbosity \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'h': batch_usage(stdout, argv[0]); return 0;
+            default:  batch_usage(stderr, argv[0]); return 2;
+        }
+    }
+    if(optind < argc)
+    {
+        batch_usage(stderr, argv[0]);
+        return 2;
+    }
+
+    if(!batch_select_tests(testList, opts.selected, &opts.numSelected))
+    {
+        fprintf(stderr, "%s: bad test list \"%s\"\n", argv[0], testList);
+        return 2;
+    }
+
+    // the kernels' trace output would interleave between threads, and a set file is written in order
+    if(verbosity == VERBOSITY_TRACE || binaryName)
+        numWorkers = 1;
+
+    if((workers = calloc(numWorkers, sizeof(batch_worker_t))) == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+    for(idx=0; idx < (int)numWorkers; idx++)
+    {
+        context_init(&workers[idx].ctx);
+        partition_init(&workers[idx].part);
+    }
+
+    if(opts.writeSets && !opts.gen)
+    {
+        fprintf(stderr, "%s: -W needs -g\n", argv[0]);
+        free(workers);
+        return 2;
+    }
+
+    if(!opts.gen && inputName && setfile_is_setfile(inputName))
+    {
+        if(!setfile_map(&file, inputName, &error))
+        {
+            fprintf(stderr, "%s: %s\n", inputName, error);
+            free(workers);
+            return 1;
+        }
+        opts.file = &file;
+    }
+    else if(!opts.gen && inputName && (in = fopen(inputName, "r")) == NULL)
+    {
+        perror(inputName);
+        free(workers);
+        return 1;
+    }
+
+    if(binaryName)
+    {
+        if(!setfile_create(&writer, binaryName))
+        {
+            perror(binaryName);
+            free(workers);
+            return 1;
+        }
+        opts.writer = &writer;
+    }
+
+    // only a trace run lets the kernels print their working, summary totals are printed here at the end
+    feasibility_verbosity = (verbosity == VERBOSITY_TRACE) ? VERBOSITY_TRACE : VERBOSITY_SILENT;
+
+    // results are small and frequent, so use a large output buffer rather than flushing per line
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    if(!opts.writeSets && !opts.writer)
+        batch_print_header(stdout, opts.format, opts.selected, opts.numSelected, opts.responseTimes, opts.simStats,
+                           opts.profile, opts.partitioned, opts.margins, opts.server != NULL);
+
+    // generated sets are made by the workers themselves, straight into their own set buffers
+    if(opts.gen)
+    {
+        for(numSets=0; ok && numSets < gen.numSets; numSets += value)
+        {
+            value = (gen.numSets - numSets < BATCH_WINDOW_SETS) ? gen.numSets - numSets : BATCH_WINDOW_SETS;
+            ok = batch_run_round(&opts, NULL, (U32_T)value, workers, numWorkers, numSets + 1);
+        }
+        for(idx=0; idx < (int)numWorkers; idx++)
+            numErrors += workers[idx].numErrors;
+        numSets -= numErrors;
+    }
+
+    // a set file needs no reading ahead, every set is already in memory
+    else if(opts.file)
+    {
+        for(numSets=0; ok && numSets < opts.file->numSets; numSets += value)
+        {
+            value = (opts.file->numSets - numSets < BATCH_WINDOW_SETS) ? opts.file->numSets - numSets : BATCH_WINDOW_SETS;
+            if(numWorkers > 1)
+                ok = batch_run_round(&opts, NULL, (U32_T)value, workers, numWorkers, numSets + 1);
+            for(idx=0; ok && numWorkers == 1 && (unsigned long)idx < value; idx++)
+                ok = batch_run_file_set(&opts, &workers[0], numSets + idx + 1, stdout);
+        }
+    }
+
+    while(ok && !opts.gen && !opts.file && getline(&line, &lineCap, in) != -1)
+    {
+        lineNo++;
+
+        // a serial run analyzes each set as it is read, a parallel one reads ahead a round's worth of sets first
+        if((rc = batch_parse_line(line, (numWorkers == 1) ? &workers[0].set : &set, &error)) == 0)
+            continue;
+        if(rc < 0)
+        {
+            fprintf(stderr, "%s:%lu: %s\n", inputName ? inputName : "stdin", lineNo, error);
+            numErrors++;
+            continue;
+        }
+        numSets++;
+
+        if(numWorkers == 1)
+            ok = batch_run_set(&opts, &workers[0], numSets, stdout);
+        else if(!batch_corpus_append(&corpus, &set))
+            ok = FALSE;
+        else if(corpus.numSets == BATCH_WINDOW_SETS)
+        {
+            ok = batch_run_round(&opts, &corpus, corpus.numSets, workers, numWorkers, numSets - corpus.numSets + 1);
+            corpus.numSets = 0;
+        }
+    }
+    if(ok && corpus.numSets)
+        ok = batch_run_round(&opts, &corpus, corpus.numSets, workers, numWorkers, numSets - corpus.numSets + 1);
+
+    fflush(stdout);
+
+    if(!ok)
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+    if(opts.writer && !setfile_close(opts.writer))
+    {
+        fprintf(stderr, "%s: cannot write %s\n", argv[0], binaryName);
+        ok = FALSE;
+    }
+    if(opts.file)
+        setfile_unmap(&file);
+
+    if(verbosity >= VERBOSITY_SUMMARY)
+    {
+        fprintf(stderr, "%lu task sets, %lu errors\n", numSets, numErrors);
+        for(idx=0; idx < opts.numSelected; idx++)
+        {
+            numFeasible = 0;
+            for(value=0; value < numWorkers; value++)
+                numFeasible += workers[value].numFeasible[idx];
+            fprintf(stderr, "  %-8s %lu feasible, %lu infeasible\n", batch_tests[opts.selected[idx]].name,
+                    numFeasible, numSets - numFeasible);
+            if(batch_tests[opts.selected[idx]].contextFn == batch_tiered_test)
+            {
+                fprintf(stderr, "  %-8s decided by", "");
+                for(rc=0; rc < TIER_COUNT; rc++)
+                {
+                    tierTotal = 0;
+                    for(value=0; value < numWorkers; value++)
+                        tierTotal += workers[value].tierDecided[rc];
+                    fprintf(stderr, "%s %s %llu", rc ? "," : "", tier_names[rc], (unsigned long long)tierTotal);
+                }
+                fputc('\n', stderr);
+            }
+            if(opts.profile)
+                batch_print_times(stderr, workers, numWorkers, idx);
+        }
+    }
+
+    free(line);
+    batch_set_free(&set);
+    batch_corpus_free(&corpus);
+    for(idx=0; idx < (int)numWorkers; idx++)
+    {
+        batch_set_free(&workers[idx].set);
+        context_free(&workers[idx].ctx);
+        partition_free(&workers[idx].part);
+        free(workers[idx].chunks);
+    }
+    free(workers);
+    if(in != stdin)
+        fclose(in);
+
+    return (numErrors || !ok) ? 1 : 0;
+}
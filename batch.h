@@ -0,0 +1,46 @@
+// Streaming batch mode for the feasibility tests
+//
+// Rather than recompiling with new global arrays, task sets can be streamed from stdin or a file, one task set per line:
+//
+//     # comment lines and blank lines are ignored
+//     [label:] T1,C1[/CH1][,D1] T2,C2[/CH2][,D2] ...
+//
+// where T is the period, C the WCET and D the deadline (D=T when omitted).  C may be given as CLO/CHI for a HI criticality
+// service with its LO and HI criticality WCETs, for the mixed criticality tests.  For fixed priority tests the services must be listed
+// highest priority first, just as for the built-in examples, unless a priority policy is given (-p) to reorder each set first.  Each task set is run through the selected tests and one compact
+// result line is written per set.
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "feasibility.h"
+
+#define BATCH_LABEL_MAX 64
+
+// One parsed task set; the arrays are reused (and grown as needed) from one record to the next
+typedef struct
+{
+    char label[BATCH_LABEL_MAX];
+    U32_T numServices;
+    U32_T capacity;
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *jitter;      // release jitter and blocking, 0 unless given in the input
+    U32_T *blocking;
+    U32_T *wcetHi;      // HI criticality WCET, 0 for a LO criticality service (every service unless given in the input)
+    U64_T *response;    // per-service response times when they are reported
+    U32_T *order;       // priority order scratch when the sets are reordered
+    U32_T *scratch;     // reordering scratch for the jitter and blocking columns
+    U32_T *maxWcet;     // sensitivity limits when they are reported
+    U32_T *minPeriod;
+    double scale;
+    int limitsValid;    // FALSE when the set is not feasible as given, so only the scale was found
+} batch_set_t;
+
+int batch_parse_line(char *line, batch_set_t *set, const char **error);
+void batch_set_free(batch_set_t *set);
+feasibility_test_fn batch_find_test(const char *name);
+int batch_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,357 @@
+// Benchmark harness for the feasibility tests - see bench.h
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "batch.h"
+#include "bench.h"
+#include "gen.h"
+#include "priority.h"
+#include "simd.h"
+
+#define BENCH_MAX_SIZES 32
+#define BENCH_MAX_TESTS 16
+#define DEFAULT_BENCH_TESTS "lub,ct,sp,dm"
+
+typedef struct
+{
+    char name[32];
+    feasibility_test_fn fn;
+} bench_test_t;
+
+// The generated sets of one grid point, numSets sets of n services stored back to back
+typedef struct
+{
+    U64_T capacity;
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *order;
+} bench_sets_t;
+
+static void bench_usage(FILE *out, const char *prog)
+{
+    fprintf(out, "usage: %s --bench [-n N[,N...]] [-u FROM:TO:STEP] [-s SETS] [-t TEST[,TEST...]] [-T TMIN:TMAX] [-d DMIN]\n"
+                 "          [-e ENGINE] [-x LEVEL] [-m MS] [-o FORMAT] [--seed SEED]\n", prog);
+    fprintf(out, "  -n, --sizes LIST      services per set (default 10,100; the exact tests slow down sharply near U=1 at 1000)\n");
+    fprintf(out, "  -u, --util RANGE      utilization grid (default 0.5:1.0:0.05)\n");
+    fprintf(out, "  -s, --sets N          sets per grid point (default 100)\n");
+    fprintf(out, "  -t, --tests LIST      tests to time, by their batch names (default %s)\n", DEFAULT_BENCH_TESTS);
+    fprintf(out, "  -T, --periods RANGE   log-uniform period range (default 1000:1000000)\n");
+    fprintf(out, "  -d, --dmin RATIO      deadlines uniform in [RATIO*T, T] (default 1, D=T)\n");
+    fprintf(out, "  -e, --engine ENGINE   optimized or reference exact test kernels\n");
+    fprintf(out, "  -x, --simd LEVEL      cap the interference sum kernels at scalar, neon, avx2 or avx512 (default %s here)\n",
+            simd_level_names[simd_best_level()]);
+    fprintf(out, "  -m, --min-time MS     minimum time per measurement (default 20)\n");
+    fprintf(out, "  -o, --format FORMAT   text or csv (default text)\n");
+    fprintf(out, "      --seed SEED       generator seed (default 1)\n");
+}
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static int parse_sizes(const char *list, U32_T sizes[], int *numSizes)
+{
+    unsigned long v;
+    char *end;
+
+    *numSizes = 0;
+    while(*list)
+    {
+        errno = 0;
+        v = strtoul(list, &end, 10);
+        if(errno || end == list || v == 0 || v > 1000000 || (*end && *end != ',') || *numSizes == BENCH_MAX_SIZES)
+            return FALSE;
+        sizes[(*numSizes)++] = (U32_T)v;
+        list = *end ? end + 1 : end;
+    }
+    return (*numSizes > 0);
+}
+
+static int parse_tests(const char *list, bench_test_t tests[], int *numTests)
+{
+    bench_test_t *test;
+    size_t len;
+
+    *numTests = 0;
+    while(*list)
+    {
+        len = strcspn(list, ",");
+        if(len == 0 || len >= sizeof(test->name) || *numTests == BENCH_MAX_TESTS)
+            return FALSE;
+        test = &tests[*numTests];
+        memcpy(test->name, list, len);
+        test->name[len] = '\0';
+        if((test->fn = batch_find_test(test->name)) == NULL)
+            return FALSE;
+        (*numTests)++;
+        list += len;
+        if(*list == ',')
+            list++;
+    }
+    return (*numTests > 0);
+}
+
+static int bench_reserve(bench_sets_t *sets, U32_T numServices, U64_T numSets)
+{
+    U32_T *p;
+
+    if((U64_T)numServices * numSets > sets->capacity)
+    {
+        sets->capacity = (U64_T)numServices * numSets;
+        if((p = realloc(sets->period, sets->capacity * sizeof(U32_T))) == NULL) return FALSE;
+        sets->period = p;
+        if((p = realloc(sets->wcet, sets->capacity * sizeof(U32_T))) == NULL) return FALSE;
+        sets->wcet = p;
+        if((p = realloc(sets->deadline, sets->capacity * sizeof(U32_T))) == NULL) return FALSE;
+        sets->deadline = p;
+    }
+    if((p = realloc(sets->order, numServices * sizeof(U32_T))) == NULL) return FALSE;
+    sets->order = p;
+
+    return TRUE;
+}
+
+// Generate the sets of one grid point, each in deadline monotonic order
+static int bench_generate(bench_sets_t *sets, const gen_params_t *gen)
+{
+    U32_T n = gen->numServices;
+    U64_T k, base;
+
+    for(k=0; k < gen->numSets; k++)
+    {
+        base = k * n;
+        if(!gen_task_set(gen, k, &sets->period[base], &sets->wcet[base], &sets->deadline[base]))
+            return FALSE;
+        priority_order(n, &sets->period[base], &sets->wcet[base], &sets->deadline[base], PRIORITY_DM, sets->order);
+        priority_permute(n, sets->order, &sets->period[base], &sets->wcet[base], &sets->deadline[base]);
+    }
+
+    return TRUE;
+}
+
+// Time one test over the sets of a grid point and print its line
+static void bench_measure(const bench_sets_t *sets, const gen_params_t *gen, const bench_test_t *test, double minTime, int csv)
+{
+    U32_T n = gen->numServices;
+    U64_T k, base, accepted = 0, reps = 0, iterations = 0, points = 0, divisions = 0;
+    feasibility_counters_t before = feasibility_counters;
+    double start = bench_now(), elapsed, nsPerSet;
+
+    // the first pass gives the acceptance and the work counts, the rest only add timing
+    do
+    {
+        for(k=0; k < gen->numSets; k++)
+        {
+            base = k * n;
+            if(test->fn(n, &sets->period[base], &sets->wcet[base], &sets->deadline[base]) == TRUE && reps == 0)
+                accepted++;
+        }
+        if(reps++ == 0)
+        {
+            iterations = feasibility_counters.iterations - before.iterations;
+            points = feasibility_counters.points - before.points;
+            divisions = feasibility_counters.divisions - before.divisions;
+        }
+        elapsed = bench_now() - start;
+    } while(elapsed < minTime);
+
+    nsPerSet = 1e9 * elapsed / ((double)reps * gen->numSets);
+    if(csv)
+        printf("%u,%.4f,%s,%llu,%llu,%.6f,%.1f,%.2f,%.2f,%.2f\n", n, gen->utilization, test->name, gen->numSets, accepted,
+               (double)accepted / gen->numSets, nsPerSet, (double)iterations / gen->numSets, (double)points / gen->numSets,
+               (double)divisions / gen->numSets);
+    else
+        printf("%7u %6.3f  %-8s %7.3f %12.1f %11.2f %11.2f %11.2f\n", n, gen->utilization, test->name,
+               (double)accepted / gen->numSets, nsPerSet, (double)iterations / gen->numSets, (double)points / gen->numSets,
+               (double)divisions / gen->numSets);
+    fflush(stdout);
+}
+
+int bench_main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        {"sizes", required_argument, NULL, 'n'},
+        {"util", required_argument, NULL, 'u'},
+        {"sets", required_argument, NULL, 's'},
+        {"tests", required_argument, NULL, 't'},
+        {"periods", required_argument, NULL, 'T'},
+        {"dmin", required_argument, NULL, 'd'},
+        {"engine", required_argument, NULL, 'e'},
+        {"simd", required_argument, NULL, 'x'},
+        {"min-time", required_argument, NULL, 'm'},
+        {"format", required_argument, NULL, 'o'},
+        {"seed", required_argument, NULL, 'S'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    U32_T sizes[BENCH_MAX_SIZES] = {10, 100};
+    bench_test_t tests[BENCH_MAX_TESTS];
+    int numSizes = 2, numTests, opt, si, ti, csv = FALSE, point = 0, rc = 0, level;
+    double uFrom = 0.5, uTo = 1.0, uStep = 0.05, u, minTime = 0.020, dmin = 1.0;
+    unsigned long numSets = 100, tmin = 1000, tmax = 1000000;
+    bench_sets_t sets = {0};
+    U64_T seed = 1;
+    gen_params_t gen;
+    char *end;
+
+    parse_tests(DEFAULT_BENCH_TESTS, tests, &numTests);
+
+    while((opt = getopt_long(argc, argv, "n:u:s:t:T:d:e:x:m:o:h", long_options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+                if(!parse_sizes(optarg, sizes, &numSizes))
+                {
+                    fprintf(stderr, "%s: bad size list \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'u':
+                if(sscanf(optarg, "%lf:%lf:%lf", &uFrom, &uTo, &uStep) != 3 || uFrom <= 0.0 || uTo < uFrom || uStep <= 0.0)
+                {
+                    fprintf(stderr, "%s: bad utilization range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 's':
+                errno = 0;
+                numSets = strtoul(optarg, &end, 10);
+                if(errno || end == optarg || *end || numSets == 0)
+                {
+                    fprintf(stderr, "%s: bad set count \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 't':
+                if(!parse_tests(optarg, tests, &numTests))
+                {
+                    fprintf(stderr, "%s: bad test list \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'T':
+                if(sscanf(optarg, "%lu:%lu", &tmin, &tmax) != 2 || tmin == 0 || tmax < tmin || tmax > 4294967295UL)
+                {
+                    fprintf(stderr, "%s: bad period range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'd':
+                if(sscanf(optarg, "%lf", &dmin) != 1 || dmin <= 0.0 || dmin > 1.0)
+                {
+                    fprintf(stderr, "%s: bad deadline ratio \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'e':
+                if(strcmp(optarg, "reference") == 0)
+                    feasibility_engine = ENGINE_REFERENCE;
+                else if(strcmp(optarg, "optimized") == 0)
+                    feasibility_engine = ENGINE_OPTIMIZED;
+                else
+                {
+                    fprintf(stderr, "%s: unknown engine \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'x':
+                for(level=SIMD_AVX512; level >= SIMD_SCALAR && strcmp(optarg, simd_level_names[level]) != 0; level--)
+                    ;
+                if(level < SIMD_SCALAR)
+                {
+                    fprintf(stderr, "%s: unknown SIMD level \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                if(simd_select(level) != level)
+                    fprintf(stderr, "%s: %s is not supported here, using %s\n", argv[0], optarg, simd_level_names[simd_level]);
+                break;
+            case 'm':
+                if(sscanf(optarg, "%lf", &minTime) != 1 || minTime < 0.0)
+                {
+                    fprintf(stderr, "%s: bad minimum time \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                minTime /= 1000.0;
+                break;
+            case 'o':
+                if(strcmp(optarg, "csv") == 0)
+                    csv = TRUE;
+                else if(strcmp(optarg, "text") != 0)
+                {
+                    fprintf(stderr, "%s: unknown format \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'S':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'h': bench_usage(stdout, argv[0]); return 0;
+            default:  bench_usage(stderr, argv[0]); return 2;
+        }
+    }
+    if(optind < argc)
+    {
+        bench_usage(stderr, argv[0]);
+        return 2;
+    }
+
+    feasibility_verbosity = VERBOSITY_SILENT;
+
+    if(csv)
+        printf("n,U,test,sets,accepted,ratio,ns_per_set,iterations_per_set,points_per_set,divisions_per_set\n");
+    else
+        printf("%7s %6s  %-8s %7s %12s %11s %11s %11s\n", "n", "U", "test", "accept", "ns/set", "iter/set", "points/set",
+               "div/set");
+
+    for(si=0; si < numSizes && rc == 0; si++)
+    {
+        if(!bench_reserve(&sets, sizes[si], numSets))
+        {
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            rc = 1;
+            break;
+        }
+
+        // small tolerance so the end of the range survives accumulated rounding in the step
+        for(u=uFrom; u <= uTo + 1e-9 && rc == 0; u += uStep, point++)
+        {
+            gen_default_params(&gen);
+            gen.numSets = numSets;
+            gen.seed = seed + (U64_T)point * 0x9E3779B97F4A7C15ULL;
+            gen.numServices = sizes[si];
+            gen.utilization = u;
+            gen.discard = (u > 1.0);
+            gen.minPeriod = (U32_T)tmin;
+            gen.maxPeriod = (U32_T)tmax;
+            gen.minDeadlineRatio = dmin;
+
+            if(!bench_generate(&sets, &gen))
+            {
+                fprintf(stderr, "%s: n=%u U=%.3f: no utilization split found\n", argv[0], sizes[si], u);
+                rc = 1;
+                break;
+            }
+
+            for(ti=0; ti < numTests; ti++)
+                bench_measure(&sets, &gen, &tests[ti], minTime, csv);
+        }
+    }
+
+    free(sets.period);
+    free(sets.wcet);
+    free(sets.deadline);
+    free(sets.order);
+    return rc;
+}
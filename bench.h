@@ -0,0 +1,18 @@
+// Benchmark harness for the feasibility tests
+//
+// Times the tests over generated task sets (gen.h) across a grid of set sizes and utilizations, and reports for each test and
+// grid point the acceptance ratio, the mean time per set and the work done per set (fixed point iterations, scheduling points
+// or QPA steps evaluated and interference divisions, see feasibility_counters_t).  Set against each other, the acceptance
+// ratios show how much a sufficient test gives away to the exact ones at each utilization, and the times what the exact answer
+// costs.
+//
+// The sets are generated once per grid point, put in deadline monotonic order, and every test runs over the same sets.  Each
+// measurement repeats the whole pass until it has run for a minimum time, so the fast tests are timed over many passes rather
+// than one clock reading per set.
+
+#ifndef BENCH_H
+#define BENCH_H
+
+int bench_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,86 @@
+// Per task set analysis context - see context.h
+
+#include <string.h>
+
+#include "context.h"
+#include "rta.h"
+#include "sim.h"
+
+void context_init(feasibility_context_t *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void context_free(feasibility_context_t *ctx)
+{
+    context_init(ctx);
+}
+
+// Bind the context to a set, forgetting everything computed for the previous one
+void context_bind(feasibility_context_t *ctx, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                  const U32_T deadline[])
+{
+    ctx->numServices = numServices;
+    ctx->period = period;
+    ctx->wcet = wcet;
+    ctx->deadline = deadline;
+    ctx->valid = 0;
+}
+
+double context_utilization(feasibility_context_t *ctx)
+{
+    double utility_sum = 0.0;
+    U32_T idx;
+
+    if(!(ctx->valid & CONTEXT_UTILIZATION))
+    {
+        for(idx=0; idx < ctx->numServices; idx++)
+            utility_sum += ((double)ctx->wcet[idx] / (double)ctx->period[idx]);
+        ctx->utilization = utility_sum;
+        ctx->valid |= CONTEXT_UTILIZATION;
+    }
+
+    return ctx->utilization;
+}
+
+int context_utilization_compare(feasibility_context_t *ctx)
+{
+    if(!(ctx->valid & CONTEXT_UTILIZATION_COMPARE))
+    {
+        ctx->utilizationCompare = utilization_compare(ctx->numServices, ctx->period, ctx->wcet);
+        ctx->valid |= CONTEXT_UTILIZATION_COMPARE;
+    }
+
+    return ctx->utilizationCompare;
+}
+
+U64_T context_hyperperiod(feasibility_context_t *ctx)
+{
+    if(!(ctx->valid & CONTEXT_HYPERPERIOD))
+    {
+        ctx->hyperperiod = sim_hyperperiod(ctx->numServices, ctx->period);
+        ctx->valid |= CONTEXT_HYPERPERIOD;
+    }
+
+    return ctx->hyperperiod;
+}
+
+double context_lub(const feasibility_context_t *ctx)
+{
+    return feasibility_lub(ctx->numServices);
+}
+
+// The RM LUB test; a trace run prints the per-service working of the original test, so it is left to sum for itself
+int context_lub_test(feasibility_context_t *ctx)
+{
+    if(feasibility_verbosity >= VERBOSITY_TRACE)
+        return rate_monotonic_least_upper_bound(ctx->numServices, (U32_T *)ctx->period, (U32_T *)ctx->wcet,
+                                                (U32_T *)ctx->deadline);
+
+    return rate_monotonic_lub_decision(ctx->numServices, context_utilization(ctx));
+}
+
+int context_utilization_100_test(feasibility_context_t *ctx)
+{
+    return (context_utilization(ctx) <= 1.0) ? TRUE : FALSE;
+}
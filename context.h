@@ -0,0 +1,51 @@
+// Per task set analysis context
+//
+// Running several tests on one set repeats the same set-wide work in each of them: the utilization test and the RM LUB both sum
+// C(i)/T(i), and every simulation finds the hyperperiod.  A context binds one set and computes each of these at most once, on
+// first use, for every test run on it through the context:
+//
+//     context_utilization          sum of C(i)/T(i) in double precision, summed in array order as the original tests do
+//     context_utilization_compare  the exact comparison of the utilization with 1 (utilization_compare)
+//     context_hyperperiod          lcm of the periods, 0 if it does not fit in 64 bits
+//     context_lub                  n(2^(1/n) - 1), from the table built at load time (feasibility_lub)
+//
+// The context keeps pointers to the arrays, not a copy, so they must not change while it is bound; bind it again after
+// modifying them.
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include "feasibility.h"
+
+// Values of a context that have been computed since it was bound
+#define CONTEXT_UTILIZATION 0x1
+#define CONTEXT_UTILIZATION_COMPARE 0x2
+#define CONTEXT_HYPERPERIOD 0x4
+
+typedef struct
+{
+    U32_T numServices;
+    const U32_T *period;
+    const U32_T *wcet;
+    const U32_T *deadline;
+    unsigned valid;             // CONTEXT_* bits of the values below that are up to date
+    double utilization;
+    int utilizationCompare;
+    U64_T hyperperiod;
+} feasibility_context_t;
+
+void context_init(feasibility_context_t *ctx);
+void context_free(feasibility_context_t *ctx);
+void context_bind(feasibility_context_t *ctx, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                  const U32_T deadline[]);
+
+double context_utilization(feasibility_context_t *ctx);
+int context_utilization_compare(feasibility_context_t *ctx);
+U64_T context_hyperperiod(feasibility_context_t *ctx);
+double context_lub(const feasibility_context_t *ctx);
+
+// The utilization tests, taking their set-wide values from the context
+int context_lub_test(feasibility_context_t *ctx);
+int context_utilization_100_test(feasibility_context_t *ctx);
+
+#endif
@@ -0,0 +1,307 @@
+// Admission control daemon - see daemon.h
+
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "admission.h"
+#include "daemon.h"
+
+// Most requests taken from one read of a connection into a batch, and the longest request line
+#define DAEMON_MAX_BATCH 256
+#define DAEMON_LINE_MAX 256
+#define DAEMON_BUFFER (DAEMON_MAX_BATCH * DAEMON_LINE_MAX)
+
+typedef struct
+{
+    admission_t *adm;
+    int fd;
+} daemon_connection_t;
+
+static volatile sig_atomic_t daemon_stop = 0;
+
+static void daemon_usage(FILE *out, const char *prog)
+{
+    fprintf(out, "usage: %s --daemon -s PATH [-c CORES] [-H HEURISTIC]\n", prog);
+    fprintf(out, "  -s, --socket PATH     UNIX socket to listen on (replaced if it exists)\n");
+    fprintf(out, "  -c, --cores N         cores to partition the admitted services over (default 1)\n");
+    fprintf(out, "  -H, --heuristic NAME  partitioning heuristic: ff, bf or wf (first, best or worst fit); default ff\n");
+    fprintf(out, "  -h, --help            show this help\n");
+    fprintf(out, "requests, one per line: add PERIOD WCET [DEADLINE] | remove ID | query ID | quit\n");
+}
+
+static void daemon_signal(int sig)
+{
+    (void)sig;
+    daemon_stop = 1;
+}
+
+// Parse one request line into req; FALSE for a line that is not a request
+static int daemon_parse(const char *line, admission_request_t *req)
+{
+    unsigned long a, b, c;
+    char op[16], extra;
+    int n;
+
+    memset(req, 0, sizeof(*req));
+    // a blank line leaves op unset
+    if((n = sscanf(line, "%15s %lu %lu %lu %c", op, &a, &b, &c, &extra)) < 1)
+        return FALSE;
+
+    if(strcmp(op, "add") == 0 && (n == 3 || n == 4) && a > 0 && a <= UINT_MAX && b <= UINT_MAX && (n == 3 || c <= UINT_MAX))
+    {
+        req->op = ADMISSION_ADD;
+        req->period = (U32_T)a;
+        req->wcet = (U32_T)b;
+        req->deadline = (n == 4) ? (U32_T)c : (U32_T)a;
+        return TRUE;
+    }
+    if((strcmp(op, "remove") == 0 || strcmp(op, "query") == 0) && n == 2 && a < ADMISSION_NO_ID)
+    {
+        req->op = (op[0] == 'r') ? ADMISSION_REMOVE : ADMISSION_QUERY;
+        req->id = (U32_T)a;
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+// TRUE when the line is the quit command, on its own apart from whitespace
+static int daemon_is_quit(const char *line)
+{
+    char op[16], extra;
+
+    return sscanf(line, "%15s %c", op, &extra) == 1 && strcmp(op, "quit") == 0;
+}
+
+static int daemon_format(char *out, size_t size, const admission_request_t *req)
+{
+    if(req->result < 0)
+        return snprintf(out, size, "error out of memory\n");
+    if(!req->result)
+        return snprintf(out, size, (req->op == ADMISSION_ADD) ? "reject\n" : "unknown\n");
+    if(req->op == ADMISSION_REMOVE)
+        return snprintf(out, size, "ok\n");
+    if(req->op == ADMISSION_ADD)
+        return snprintf(out, size, "ok %u %u %llu\n", req->id, req->core, (unsigned long long)req->response);
+    return snprintf(out, size, "ok %u %llu\n", req->core, (unsigned long long)req->response);
+}
+
+static int daemon_write(int fd, const char *buf, size_t length)
+{
+    ssize_t n;
+
+    while(length)
+    {
+        if((n = write(fd, buf, length)) < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return FALSE;
+        }
+        buf += n;
+        length -= n;
+    }
+    return TRUE;
+}
+
+/* Answer one connection: the complete lines read so far, up to a batch of them, are submitted as one batch and answered in one
+ * write, and the connection is only read again once every complete line has been answered.  A line that is not a request is
+ * answered "error" in its place.
+ */
+static void *daemon_serve(void *arg)
+{
+    daemon_connection_t *conn = arg;
+    admission_request_t requests[DAEMON_MAX_BATCH];
+    int valid[DAEMON_MAX_BATCH], count, numRequests, idx, quit = FALSE;
+    size_t have = 0, length;
+    char *in, *out, *line, *eol;
+    ssize_t n;
+
+    in = malloc(DAEMON_BUFFER + 1);
+    out = malloc(DAEMON_MAX_BATCH * DAEMON_LINE_MAX);
+    while(in && out && !quit)
+    {
+        in[have] = '\0';
+        if(strchr(in, '\n') == NULL)
+        {
+            // a line longer than the buffer can never complete
+            if(have == DAEMON_BUFFER || (n = read(conn->fd, in + have, DAEMON_BUFFER - have)) <= 0)
+                break;
+            have += n;
+            continue;
+        }
+
+        line = in;
+        count = numRequests = 0;
+        while(count < DAEMON_MAX_BATCH && (eol = strchr(line, '\n')) != NULL)
+        {
+            *eol = '\0';
+            if(daemon_is_quit(line))
+            {
+                quit = TRUE;
+                break;
+            }
+            if((valid[count] = daemon_parse(line, &requests[numRequests])))
+                numRequests++;
+            count++;
+            line = eol + 1;
+        }
+
+        admission_submit(conn->adm, requests, numRequests);
+
+        length = 0;
+        for(idx=0, numRequests=0; idx < count; idx++)
+        {
+            if(valid[idx])
+                length += daemon_format(out + length, DAEMON_LINE_MAX, &requests[numRequests++]);
+            else
+                length += snprintf(out + length, DAEMON_LINE_MAX, "error\n");
+        }
+        if(!daemon_write(conn->fd, out, length))
+            break;
+
+        have -= line - in;
+        memmove(in, line, have);
+    }
+
+    free(in);
+    free(out);
+    close(conn->fd);
+    free(conn);
+    return NULL;
+}
+
+int daemon_main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        {"socket", required_argument, NULL, 's'},
+        {"cores", required_argument, NULL, 'c'},
+        {"heuristic", required_argument, NULL, 'H'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    const char *path = NULL;
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    daemon_connection_t *conn;
+    admission_t adm;
+    pthread_attr_t attr;
+    pthread_t thread;
+    unsigned long numCores = 1;
+    int opt, heuristic = PARTITION_FF, listenFd, fd;
+    char *end;
+
+    while((opt = getopt_long(argc, argv, "s:c:H:h", long_options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 's':
+                path = optarg;
+                break;
+            case 'c':
+                errno = 0;
+                numCores = strtoul(optarg, &end, 10);
+                if(errno || end == optarg || *end || numCores == 0 || numCores > UINT_MAX)
+                {
+                    fprintf(stderr, "%s: bad core count \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'H':
+                for(heuristic=PARTITION_WF; heuristic >= PARTITION_FF && strcmp(optarg, partition_heuristic_names[heuristic]);
+                    heuristic--)
+                    ;
+                if(heuristic < PARTITION_FF)
+                {
+                    fprintf(stderr, "%s: unknown partitioning heuristic \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'h': daemon_usage(stdout, argv[0]); return 0;
+            default:  daemon_usage(stderr, argv[0]); return 2;
+        }
+    }
+    if(optind < argc || !path)
+    {
+        daemon_usage(stderr, argv[0]);
+        return 2;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "%s: socket path too long \"%s\"\n", argv[0], path);
+        return 2;
+    }
+    strcpy(addr.sun_path, path);
+
+    if(!admission_init(&adm, (U32_T)numCores, heuristic))
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    unlink(path);
+    if((listenFd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+       listen(listenFd, SOMAXCONN) < 0)
+    {
+        perror(path);
+        admission_free(&adm);
+        return 1;
+    }
+
+    // no SA_RESTART, so a signal interrupts accept and the loop ends; a client that goes away must not kill the daemon
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = daemon_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    feasibility_verbosity = VERBOSITY_SILENT;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    fprintf(stderr, "%s: listening on %s, %lu core%s, %s\n", argv[0], path, numCores, (numCores == 1) ? "" : "s",
+            partition_heuristic_names[heuristic]);
+
+    while(!daemon_stop)
+    {
+        if((fd = accept(listenFd, NULL, NULL)) < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            perror("accept");
+            break;
+        }
+        if((conn = malloc(sizeof(*conn))) == NULL)
+        {
+            close(fd);
+            continue;
+        }
+        conn->adm = &adm;
+        conn->fd = fd;
+        if(pthread_create(&thread, &attr, daemon_serve, conn) != 0)
+        {
+            close(fd);
+            free(conn);
+        }
+    }
+
+    // connections still open keep the controller, so it is left to the process exit rather than freed under them
+    pthread_attr_destroy(&attr);
+    close(listenFd);
+    unlink(path);
+    fprintf(stderr, "%s: %llu requests in %llu batches, %u services admitted\n", argv[0],
+            (unsigned long long)adm.numRequests, (unsigned long long)adm.numBatches, adm.numAdmitted);
+    return 0;
+}
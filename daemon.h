@@ -0,0 +1,19 @@
+// Admission control daemon
+//
+// Serves an admission controller (admission.h) on a UNIX stream socket, so services can be admitted and released at runtime by
+// other processes.  Each connection is answered by its own thread, one line per request, in the order sent:
+//
+//     add PERIOD WCET [DEADLINE]   ok ID CORE RESPONSE, reject, or error (the deadline defaults to the period)
+//     remove ID                    ok, or unknown
+//     query ID                     ok CORE RESPONSE, or unknown
+//     quit                         closes the connection
+//
+// Requests a client sends together (pipelined, without waiting for each answer) are submitted to the controller as one batch,
+// and batches from different connections are combined by the controller itself.
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+int daemon_main(int argc, char *argv[]);
+
+#endif
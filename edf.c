@@ -0,0 +1,175 @@
+// Exact EDF feasibility by processor demand analysis - see edf.h
+
+#include "edf.h"
+#include "rta.h"
+#include "sim.h"
+
+// Steps of the busy period fixed point before La, or the hyperperiod when U = 1 and it fits, is taken as the bound instead
+#define EDF_BUSY_PERIOD_ITERATIONS 1024
+
+// h(t), the total execution of every job with release and deadline inside [0, t]; FALSE if the sum overflows
+static int edf_demand(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], U64_T t,
+                      U64_T *demand)
+{
+    U64_T sum = 0, term;
+    U32_T i;
+
+    FEASIBILITY_COUNT(points, 1);
+    for(i=0; i < numServices; i++)
+    {
+        if(deadline[i] > t)
+            continue;
+        FEASIBILITY_COUNT(divisions, 1);
+        if(__builtin_mul_overflow((t - deadline[i]) / period[i] + 1, (U64_T)wcet[i], &term) ||
+           __builtin_add_overflow(sum, term, &sum))
+            return FALSE;
+    }
+
+    *demand = sum;
+    return TRUE;
+}
+
+// The largest absolute deadline k*T(i) + D(i) strictly before t, or 0 if there is none
+static U64_T edf_deadline_before(U32_T numServices, const U32_T period[], const U32_T deadline[], U64_T t)
+{
+    U64_T best = 0, d;
+    U32_T i;
+
+    for(i=0; i < numServices; i++)
+    {
+        if(deadline[i] >= t)
+            continue;
+        FEASIBILITY_COUNT(divisions, 1);
+        d = deadline[i] + (t - 1 - deadline[i]) / period[i] * period[i];
+        if(d > best)
+            best = d;
+    }
+
+    return best;
+}
+
+/* Length of the synchronous busy period Lb, the fixed point of w = sum of ceil(w/T(i))*C(i).  It exists whenever U <= 1 and is
+ * at most the hyperperiod.  Only min(Lb, limit) is needed, so the iteration stops as soon as w reaches limit, and a sum too
+ * large for 64 bits saturates past it.  A climb of EDF_BUSY_PERIOD_ITERATIONS steps stops at limit, or with no limit (~0) at
+ * the hyperperiod when that fits in 64 bits; otherwise the iteration carries on to Lb.  FALSE is returned only if there is no
+ * limit and Lb does not fit in 64 bits.
+ */
+static int edf_busy_period(U32_T numServices, const U32_T period[], const U32_T wcet[], U64_T limit, U64_T *length)
+{
+    U64_T w = 0, wnext, term, hyperperiod;
+    U32_T i, iterations = 0;
+
+    // at most 2^32 WCETs below 2^32, so the first sum always fits
+    for(i=0; i < numServices; i++)
+        w += wcet[i];
+
+    while(w < limit)
+    {
+        // a long climb: La bounds the analysis as well, and for U = 1 so does the hyperperiod when it can be represented
+        if(++iterations == EDF_BUSY_PERIOD_ITERATIONS)
+        {
+            if(limit != ~0ULL)
+            {
+                w = limit;
+                break;
+            }
+            if((hyperperiod = sim_hyperperiod(numServices, period)) != 0)
+            {
+                w = hyperperiod;
+                break;
+            }
+        }
+
+        wnext = 0;
+        FEASIBILITY_COUNT(divisions, numServices);
+        for(i=0; i < numServices && wnext != ~0ULL; i++)
+        {
+            if(__builtin_mul_overflow(w / period[i] + (w % period[i] != 0), (U64_T)wcet[i], &term) ||
+               __builtin_add_overflow(wnext, term, &wnext))
+                wnext = ~0ULL;
+        }
+
+        if(wnext == w)
+            break;
+        w = wnext;
+    }
+
+    if(w == ~0ULL && limit == ~0ULL)
+        return FALSE;
+    *length = (w < limit) ? w : limit;
+    return TRUE;
+}
+
+/* Exact EDF test by QPA.  The demand only has to be checked at absolute deadlines before min(La, Lb), where Lb is the synchronous
+ * busy period and, for U < 1, La = max(max(D(i) - T(i)), sum((T(i) - D(i))*U(i))/(1 - U)).  Starting from the last deadline
+ * before that bound, t moves to h(t) when h(t) < t and to the previous deadline when h(t) = t; the set is feasible once h(t)
+ * drops to the shortest relative deadline, and infeasible as soon as h(t) > t.  U > 1 is infeasible without further analysis,
+ * and with no deadline short of its period U <= 1 is enough, since h(t) <= U*t.  For U = 1 the busy period is the hyperperiod
+ * itself, since the demand of [0, t) only equals t at a common multiple of the periods, so a set that also needs the analysis is
+ * only reported infeasible when the hyperperiod does not fit in 64 bits.
+ */
+int edf_demand_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    long double utility_sum = 0.0L, weighted = 0.0L, la;
+    U64_T bound = ~0ULL, t, h, dmin = ~0ULL;
+    int ucmp, constrained = FALSE;
+    U32_T i;
+
+    if(numServices == 0)
+        return TRUE;
+
+    if((ucmp = utilization_compare(numServices, period, wcet)) > 0)
+        return FALSE;
+
+    for(i=0; i < numServices; i++)
+    {
+        if(deadline[i] < dmin)
+            dmin = deadline[i];
+        if(deadline[i] < period[i])
+            constrained = TRUE;
+        utility_sum += (long double)wcet[i] / (long double)period[i];
+        weighted += ((long double)period[i] - (long double)deadline[i]) * wcet[i] / period[i];
+    }
+
+    if(!constrained)
+        return TRUE;
+
+    if(ucmp == 0)
+    {
+        if((bound = sim_hyperperiod(numServices, period)) == 0)
+            return FALSE;
+    }
+    else if(utility_sum < 1.0L)
+    {
+        // the division is only an estimate, so round La up by one; a larger bound only costs time
+        la = weighted / (1.0L - utility_sum);
+        for(i=0; i < numServices; i++)
+            if((long double)deadline[i] - (long double)period[i] > la)
+                la = (long double)deadline[i] - (long double)period[i];
+        if(la < 0.0L)
+            la = 0.0L;
+        if(la + 1.0L < 18446744073709551615.0L)
+            bound = (U64_T)la + 1;
+    }
+
+    // Lb is only iterated up to La, so a set whose busy period is long next to La skips most of it
+    if(ucmp < 0 && !edf_busy_period(numServices, period, wcet, bound, &bound))
+        return FALSE;
+
+    if((t = edf_deadline_before(numServices, period, deadline, bound)) == 0)
+        return TRUE;
+
+    while(1)
+    {
+        if(!edf_demand(numServices, period, wcet, deadline, t, &h) || h > t)
+            return FALSE;
+
+        if(h <= dmin)
+            return TRUE;
+
+        if(h < t)
+            t = h;
+        else if((t = edf_deadline_before(numServices, period, deadline, t)) == 0)
+            return TRUE;
+    }
+}
@@ -0,0 +1,19 @@
+// Exact EDF feasibility by processor demand analysis
+//
+// utilization_100_test is only exact for EDF when D=T.  For constrained or arbitrary deadlines a set is EDF feasible if and only
+// if U <= 1 and the demand bound function
+//
+//     h(t) = sum over D(i) <= t of (floor((t - D(i))/T(i)) + 1) * C(i)
+//
+// never exceeds t.  QPA (Zhang and Burns, "Schedulability analysis for real-time systems with EDF scheduling", IEEE TC 2009)
+// checks this by walking backwards from the largest deadline below the analysis bound, jumping straight to t = h(t) whenever
+// h(t) < t, so only a handful of the absolute deadlines up to the bound are ever visited.
+
+#ifndef EDF_H
+#define EDF_H
+
+#include "feasibility.h"
+
+int edf_demand_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+#endif
@@ -0,0 +1,279 @@
+// Feasibility test kernels shared by the example program, the batch drivers and libfeasibility - see feasibility.h
+//
+// These are the original single core tests from feasibility_tests.c (RM LUB, completion test, scheduling point test, the 100%
+// utilization test and the DM quick test) with the runtime settings they read.  The exact tests dispatch to the integer engines
+// in rta.c and schedpoint.c unless the reference engine is selected.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "feasibility.h"
+#include "rta.h"
+#include "schedpoint.h"
+
+// library callers get silent kernels, the example program turns the trace on for its own runs
+int feasibility_verbosity = VERBOSITY_SILENT;
+int feasibility_engine = ENGINE_OPTIMIZED;
+__thread feasibility_counters_t feasibility_counters;
+
+static double feasibility_lub_table[FEASIBILITY_LUB_TABLE];
+
+// the bound for each small n is computed once at load time rather than by pow() on every test
+__attribute__((constructor))
+static void feasibility_lub_init(void)
+{
+  U32_T n;
+
+  for(n=0; n < FEASIBILITY_LUB_TABLE; n++)
+    feasibility_lub_table[n] = (double)n * (pow(2.0, (1.0/((double)n))) - 1.0);
+}
+
+double feasibility_lub(U32_T numServices)
+{
+  if(numServices < FEASIBILITY_LUB_TABLE)
+    return feasibility_lub_table[numServices];
+
+  return (double)numServices * (pow(2.0, (1.0/((double)numServices))) - 1.0);
+}
+
+int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+  double utility_sum=0.0;
+  int idx;
+
+  if(feasibility_verbosity >= VERBOSITY_TRACE)
+    printf("for %d, utility_sum = %lf\n", numServices, utility_sum);
+
+  // Sum the C(i) over the T(i)
+  for(idx=0; idx < numServices; idx++)
+  {
+    utility_sum += ((double)wcet[idx] / (double)period[idx]);
+    if(feasibility_verbosity >= VERBOSITY_TRACE)
+      printf("for %d, wcet=%lf, period=%lf, utility_sum = %lf\n", idx, (double)wcet[idx], (double)period[idx], utility_sum);
+  }
+
+  return rate_monotonic_lub_decision(numServices, utility_sum);
+}
+
+// The LUB test for a utilization already summed, which the analysis context shares between tests
+int rate_monotonic_lub_decision(U32_T numServices, double utility_sum)
+{
+  double lub;
+
+  if(feasibility_verbosity >= VERBOSITY_SUMMARY)
+    printf("utility_sum = %lf\n", utility_sum);
+
+  // Look up the LUB for number of services
+  lub = feasibility_lub(numServices);
+  if(feasibility_verbosity >= VERBOSITY_SUMMARY)
+    printf("LUB = %lf\n", lub);
+
+  // Compare the utilty to the bound and return feasibility
+  if(utility_sum <= lub)
+	  return TRUE;
+  else
+	  return FALSE;
+}
+
+/* The completion‑time feasibility test computes the worst‑case response time
+ * for each task by accounting for interference from all higher‑priority tasks.
+ * We begin with an initial estimate equal to the sum of execution times for
+ * the task and all higher‑priority tasks. We then iteratively add additional
+ * interference based on how many times each higher‑priority task can release
+ * within the current response‑time estimate. This process continues until the
+ * value converges, giving the worst‑case completion time under maximum load.
+ * If this final response time does not exceed the task’s deadline, the task
+ * is schedulable under fixed‑priority (RM) analysis. NOTE: I had an AI revise this comment as 
+ * I was getting a bit wordy but it matches my thoughts and is based on my description.
+ */
+
+ /* CHANGE NOTE: This function works for DM and RM as long as they are ordered correctly for the corresponding policy. 
+  * No change was needed in this function, for DM applicability, just must order as shortest deadline has the highest priority.  This is because the function simply accounts for interference from higher priority tasks, and if the order of the tasks is correct for the policy, then the function will work for either RM or DM.
+  */
+ int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+  if(feasibility_engine == ENGINE_REFERENCE)
+    return completion_time_feasibility_fp(numServices, period, wcet, deadline);
+
+  return rta_feasibility(numServices, period, wcet, deadline);
+}
+
+/* Reference double precision version of the completion test, selected with ENGINE_REFERENCE.  The default engine is the integer
+ * version in rta.c which computes the same fixed point with exact ceiling division.
+ */
+int completion_time_feasibility_fp(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+  int i, j;
+  U32_T an, anext;
+  
+  // assume feasible until we find otherwise
+  int set_feasible=TRUE;
+   
+  //printf("numServices=%d\n", numServices);
+ 
+  // For all services in the analysis - why the double loop?
+  for (i=0; i < numServices; i++)
+  {
+       an=0; anext=0;
+       
+       for (j=0; j <= i; j++)
+       {
+           an+=wcet[j];
+       }
+       
+	   //printf("i=%d, an=%d\n", i, an);
+
+       while(1)
+       {
+             anext=wcet[i];
+             FEASIBILITY_COUNT(iterations, 1);
+             FEASIBILITY_COUNT(divisions, i);
+	     
+             for (j=0; j < i; j++)
+                 anext += ceil(((double)an)/((double)period[j]))*wcet[j];
+		 
+             // the estimate only grows, so once it passes the deadline the service has missed it; without this the
+             // iteration never ends when the services up to i use more than the whole processor
+             if (anext == an || anext > deadline[i])
+             {
+                an=anext;
+                break;
+             }
+             else
+                an=anext;
+
+			 //printf("an=%d, anext=%d\n", an, anext);
+       }
+       
+	   //printf("an=%d, deadline[%d]=%d\n", an, i, deadline[i]);
+
+       if (an > deadline[i])
+       {
+          set_feasible=FALSE;
+       }
+  }
+  
+  return set_feasible;
+}
+
+/* To the best of my knowledge... The scheduling‑point feasibility test examines all critical instants, which occur at multiples of higher‑priority task periods, up to the
+ * period of the task being analyzed. At each such time t, the test checks whether the processor can supply enough CPU time to handle all jobs
+ * released by tasks of equal or higher priority. The right side of the inequality is the available CPU time t, while the left side is the sum
+ * of each higher‑priority task’s execution time multiplied by the number of times it can release within that window. If demand is less than or
+ * equal to supply at any scheduling point, the task is feasible; if not, the task set is infeasible under fixed‑priority scheduling.
+ */
+
+ /* CHANGE NOTE: This function works for RM and DM policy as long as the services are ordered correctly for the policy in use.
+ *  This is shortest period for RM and shortest deadline for DM. The only modification to the function was on line 410, note there. 
+ */
+int scheduling_point_feasibility(U32_T numServices, U32_T period[], 
+				 U32_T wcet[], U32_T deadline[])
+{
+   if(feasibility_engine == ENGINE_REFERENCE)
+      return scheduling_point_feasibility_naive(numServices, period, wcet, deadline);
+
+   return scheduling_point_feasibility_reduced(numServices, period, wcet, deadline);
+}
+
+/* Reference version that enumerates every l*period[k] point, selected with ENGINE_REFERENCE.  The default engine in schedpoint.c
+ * checks only the reduced Bini-Buttazzo point set.  The two agree when D=T; for D<T this version does not check the deadline
+ * itself as a point, so it can reject sets the reduced engine (and the completion test) accept.
+ */
+int scheduling_point_feasibility_naive(U32_T numServices, U32_T period[], 
+				 U32_T wcet[], U32_T deadline[])
+{
+   int rc = TRUE, i, j, k, l, status, temp;
+
+   // For all services in the analysis
+   for (i=0; i < numServices; i++) // iterate from highest to lowest priority
+   {
+      status=0;
+
+      // Look for all available CPU minus what has been used by higher priority services
+      for (k=0; k<=i; k++) 
+      {
+	  // find available CPU windows and take them
+      // all I must change here is from period to deadline to ensure all higher priotity interfering tasks still
+      // allow for completion of the task under test before the task's deadline instead of its period.
+          for (l=1; l <= (floor((double)deadline[i]/(double)period[k])); l++)
+          {
+               temp=0;
+               FEASIBILITY_COUNT(points, 1);
+               FEASIBILITY_COUNT(divisions, i+1);
+
+               for (j=0; j<=i; j++) temp += wcet[j] * ceil((double)l*(double)period[k]/(double)period[j]);
+
+	       // Can we get the CPU we need or not?
+               if (temp <= (l*period[k]))
+			   {
+				   // insufficient CPU during our period, therefore infeasible
+				   status=1;
+				   break;
+			   }
+           }
+           if (status) break;
+      }
+
+      if (!status) rc=FALSE;
+   }
+   return rc;
+}
+
+/*This is a simple function to compare utilization against 100%. For dynamic priority algorithms such as EDF and LLF,
+* this is a necessary and sufficient condition for feasibility. If under 100% utilization, the system is feasible using a
+* EDF or LLF shceduler. If over 100% the schedule is infeasible.
+*/
+int utilization_100_test(U32_T numServices, U32_T period[], U32_T wcet[]){
+    
+    double utility_sum=0.0;
+    int idx;
+
+    // Sum the C(i) over the T(i) for all services
+    for(idx=0; idx < numServices; idx++)
+    {
+        utility_sum += ((double)wcet[idx] / (double)period[idx]);
+    }
+
+    // Compare the utilty to 1.0 and return feasibility if under this value
+    if(utility_sum <= 1.0)
+        return TRUE;
+    else
+        return FALSE;
+}
+/* This function below implements equation 3.14 from the textbook and is a sufficient test to prove that the deadline monotonic
+*  schedule is feasible. It is only sufficient like the LUB and is not necessary (i.e. proves will work but fails to prove will not work).
+*  I was a little unclear on our reqs so I modified the feasibility tests as noted in them, and added this as well. I had a small error an 
+*  AI helped me find and fix since I was a bit tired, but I understand the test and it is based on the same principle as the completion time test, but with a different 
+*  equation. It accounts for interference from higher priority tasks, but instead of iteratively computing the response time, it simply computes 
+*  the demand over the deadline interval and compares it to 1.0.
+*/
+int dm_quick_test(U32_T numServices, U32_T wcet[], U32_T period[], U32_T deadline[])
+{
+    for (int i = 0; i < numServices; i++)
+    {
+        double Ci = (double)wcet[i];
+        double Di = (double)deadline[i];
+
+        // compute interference from all higher‑priority tasks
+        double Ii = 0.0;
+
+        for (int hp = 0; hp < i; hp++)
+        {
+            double Tj = (double)period[hp];
+            double Cj = (double)wcet[hp];
+
+            // number of releases of task hp inside window Di
+            double nj = ceil(Di / Tj);
+
+            Ii += nj * Cj;
+        }
+
+        // normalized demand test
+        double lhs = (Ci + Ii) / Di;
+
+        if (lhs > 1.0)
+            return FALSE;   // fails sufficient test
+    }
+
+    return TRUE;            // passes sufficient test
+}
\ No newline at end of file
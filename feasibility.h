@@ -0,0 +1,67 @@
+// Shared definitions for the feasibility tests
+//
+// The analysis kernels all take the same parallel arrays that the original example code used: period[], wcet[] and deadline[]
+// indexed by service, with numServices giving the number of valid entries.  For fixed priority tests the arrays must already be
+// ordered highest priority first (shortest period for RM, shortest deadline for DM).
+
+#ifndef FEASIBILITY_H
+#define FEASIBILITY_H
+
+#define TRUE 1
+#define FALSE 0
+#define U32_T unsigned int
+#define U64_T unsigned long long
+
+// Verbosity of the test kernels themselves: SILENT does no formatted I/O at all, SUMMARY prints one result line per call and
+// TRACE adds the per-service working.  The default is SILENT; the built-in examples run at TRACE.
+#define VERBOSITY_SILENT 0
+#define VERBOSITY_SUMMARY 1
+#define VERBOSITY_TRACE 2
+
+extern int feasibility_verbosity;
+
+// Kernel implementation used by the exact tests: OPTIMIZED (the default) selects the integer engines, REFERENCE the original
+// double precision code and full scheduling point enumeration, which are kept for cross-checking.
+#define ENGINE_REFERENCE 0
+#define ENGINE_OPTIMIZED 1
+
+extern int feasibility_engine;
+
+// Work done by the exact tests on the calling thread, for benchmarking: fixed point iterations of the completion tests, demand
+// evaluations at scheduling points (or QPA steps), and the ceiling and floor divisions of the interference and demand terms
+// (each vector lane counting as one).  The counters only ever increase; take differences around a call.  Building with
+// -DFEASIBILITY_NO_COUNTERS removes the counting from the kernels altogether, and the counters then stay at zero.
+typedef struct
+{
+    U64_T iterations;
+    U64_T points;
+    U64_T divisions;
+} feasibility_counters_t;
+
+extern __thread feasibility_counters_t feasibility_counters;
+
+#ifdef FEASIBILITY_NO_COUNTERS
+#define FEASIBILITY_COUNT(counter, n) ((void)0)
+#else
+#define FEASIBILITY_COUNT(counter, n) (feasibility_counters.counter += (n))
+#endif
+
+// n(2^(1/n) - 1), the RM least upper bound for n services; looked up in a table built at load time below FEASIBILITY_LUB_TABLE
+#define FEASIBILITY_LUB_TABLE 1024
+
+double feasibility_lub(U32_T numServices);
+
+// Common signature used by the batch driver to run any of the tests over a parsed task set
+typedef int (*feasibility_test_fn)(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+//FUNCTION PROTOTYPES
+int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int completion_time_feasibility_fp(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int scheduling_point_feasibility_naive(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int rate_monotonic_lub_decision(U32_T numServices, double utility_sum);
+int utilization_100_test(U32_T numServices, U32_T period[], U32_T wcet[]);
+int dm_quick_test(U32_T numServices, U32_T wcet[], U32_T period[], U32_T deadline[]);
+
+#endif
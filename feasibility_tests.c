@@ -49,10 +49,18 @@
 //LIBRARIES - so far nothing related to threads is included
 #include <math.h>
 #include <stdio.h>
-
-#define TRUE 1
-#define FALSE 0
-#define U32_T unsigned int
+#include <string.h>
+
+#include "feasibility.h"
+#include "batch.h"
+#include "bench.h"
+#include "daemon.h"
+#include "sweep.h"
+#include "verify.h"
+#include "context.h"
+#include "edf.h"
+#include "rta.h"
+#include "schedpoint.h"
 
 //EXAMPLE SERVICES
 // EX0: U=0.7333
@@ -99,17 +107,71 @@ U32_T ex8_wcet[] = {1, 1, 1, 2};
 U32_T ex9_period[] = {6, 8, 12, 24};
 U32_T ex9_wcet[] = {1, 2, 4, 6};
 
-//FUNCTION PROTOTYPES
-int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int scheduling_point_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
-int utilization_100_test(U32_T numServices, U32_T period[], U32_T wcet[]);
-int dm_quick_test(U32_T numServices, U32_T wcet[], U32_T period[], U32_T deadline[]);
+// Print the examples above in the batch input format, one labeled set per line, so they can be analyzed or converted in batch mode
+static int print_examples(void)
+{
+    static const struct
+    {
+        const char *label;
+        U32_T numServices;
+        const U32_T *period, *wcet, *deadline;
+    } examples[] =
+    {
+        {"ex0", 3, ex0_period, ex0_wcet, ex0_period},
+        {"ex1", 3, ex1_period, ex1_wcet, ex1_period},
+        {"ex2", 4, ex2_period, ex2_wcet, ex2_period},
+        {"ex3", 3, ex3_period, ex3_wcet, ex3_period},
+        {"ex4", 3, ex4_period, ex4_wcet, ex4_period},
+        {"ex5", 3, ex5_period, ex5_wcet, ex5_period},
+        {"ex6", 4, ex6_period, ex6_wcet, ex6_deadline},
+        {"ex7", 3, ex7_period, ex7_wcet, ex7_period},
+        {"ex8", 4, ex8_period, ex8_wcet, ex8_period},
+        {"ex9", 4, ex9_period, ex9_wcet, ex9_period},
+    };
+    U32_T ex, idx;
+
+    for(ex=0; ex < sizeof(examples) / sizeof(examples[0]); ex++)
+    {
+        printf("%s:", examples[ex].label);
+        for(idx=0; idx < examples[ex].numServices; idx++)
+            printf(" %u,%u,%u", examples[ex].period[idx], examples[ex].wcet[idx], examples[ex].deadline[idx]);
+        printf("\n");
+    }
+
+    return 0;
+}
+
+// The arguments after a mode option, with the program name in place of the option so the mode's messages name the program
+static char **mode_arguments(char *argv[])
+{
+    argv[1] = argv[0];
+    return argv + 1;
+}
 
-int main(void)
+int main(int argc, char *argv[])
 { 
     int i;
 	U32_T numServices;
+    feasibility_context_t ctx;
+
+    // Any command line arguments select the streaming batch mode (or --bench the benchmark harness, --verify the differential
+    // verification, --sweep the acceptance and breakdown sweep, --daemon the admission control daemon, --examples the examples
+    // below as batch input), otherwise run the built-in examples below
+    if(argc > 1 && strcmp(argv[1], "--bench") == 0)
+        return bench_main(argc - 1, mode_arguments(argv));
+    if(argc > 1 && strcmp(argv[1], "--verify") == 0)
+        return verify_main(argc - 1, mode_arguments(argv));
+    if(argc > 1 && strcmp(argv[1], "--sweep") == 0)
+        return sweep_main(argc - 1, mode_arguments(argv));
+    if(argc > 1 && strcmp(argv[1], "--daemon") == 0)
+        return daemon_main(argc - 1, mode_arguments(argv));
+    if(argc > 1 && strcmp(argv[1], "--examples") == 0)
+        return print_examples();
+    if(argc > 1)
+        return batch_main(argc, argv);
+
+    feasibility_verbosity = VERBOSITY_TRACE;
+    context_init(&ctx);
     
     // COMPLETION TESTS
     printf("******** Completion Test Feasibility Example\n");
@@ -281,6 +343,8 @@ int main(void)
     printf("Ex-5 U=%4.2f%% (C1=1, C2=2, C3=1; T1=2, T2=5, T3=10; T=D): ",
 		   ((1.0/2.0)*100.0 + (2.0/5.0)*100.0 + (1.0/10.0)*100.0));
 	numServices = 3;
+    // from here each example's tests share one analysis context, which sums its utilization once
+    context_bind(&ctx, numServices, ex5_period, ex5_wcet, ex5_period);
     if(completion_time_feasibility(numServices, ex5_period, ex5_wcet, ex5_period) == TRUE)
         printf("\nCompletion Time Test FEASIBLE\n");
     else
@@ -289,11 +353,11 @@ int main(void)
         printf("Scheduling Point Test FEASIBLE\n");
     else
         printf("Scheduling Point Test INFEASIBLE\n");
-    if(rate_monotonic_least_upper_bound(numServices, ex5_period, ex5_wcet, ex5_period) == TRUE)
+    if(context_lub_test(&ctx) == TRUE)
         printf("RM LUB FEASIBLE\n");
     else
         printf("RM LUB INFEASIBLE\n");
-    if(utilization_100_test(numServices, ex5_period, ex5_wcet) == TRUE)
+    if(context_utilization_100_test(&ctx) == TRUE)
         printf("EDF and LLF FEASIBLE\n");
     else
         printf("EDF and LLF INFEASIBLE\n");
@@ -303,6 +367,7 @@ int main(void)
     printf("Ex-7 U=%4.2f%% (C1=1, C2=2, C3=4; T1=3, T2=5, T3=15; T=D): ",
 		   ((1.0/3.0)*100.0 + (2.0/5.0)*100.0 + (4.0/15.0)*100.0));
 	numServices = 3;
+    context_bind(&ctx, numServices, ex7_period, ex7_wcet, ex7_period);
     if(completion_time_feasibility(numServices, ex7_period, ex7_wcet, ex7_period) == TRUE)
         printf("\nCompletion Time Test FEASIBLE\n");
     else
@@ -311,11 +376,11 @@ int main(void)
         printf("Scheduling Point Test FEASIBLE\n");
     else
         printf("Scheduling Point Test INFEASIBLE\n");
-    if(rate_monotonic_least_upper_bound(numServices, ex7_period, ex7_wcet, ex7_period) == TRUE)
+    if(context_lub_test(&ctx) == TRUE)
         printf("RM LUB FEASIBLE\n");
     else
         printf("RM LUB INFEASIBLE\n");
-    if(utilization_100_test(numServices, ex7_period, ex7_wcet) == TRUE)
+    if(context_utilization_100_test(&ctx) == TRUE)
         printf("EDF and LLF FEASIBLE\n");
     else
         printf("EDF and LLF INFEASIBLE\n");
@@ -325,6 +390,7 @@ int main(void)
     printf("Ex-8 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; T=D): ",
 		   ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
 	numServices = 4;
+    context_bind(&ctx, numServices, ex8_period, ex8_wcet, ex8_period);
     if(completion_time_feasibility(numServices, ex8_period, ex8_wcet, ex8_period) == TRUE)
         printf("\nCompletion Time Test FEASIBLE\n");
     else
@@ -333,11 +399,11 @@ int main(void)
         printf("Scheduling Point Test FEASIBLE\n");
     else
         printf("Scheduling Point Test INFEASIBLE\n");
-    if(rate_monotonic_least_upper_bound(numServices, ex8_period, ex8_wcet, ex8_period) == TRUE)
+    if(context_lub_test(&ctx) == TRUE)
         printf("RM LUB FEASIBLE\n");
     else
         printf("RM LUB INFEASIBLE\n");
-    if(utilization_100_test(numServices, ex8_period, ex8_wcet) == TRUE)
+    if(context_utilization_100_test(&ctx) == TRUE)
         printf("EDF and LLF FEASIBLE\n");
     else
         printf("EDF and LLF INFEASIBLE\n");
@@ -347,6 +413,7 @@ int main(void)
     printf("Ex-9 U=%4.2f%% (C1=1, C2=2, C3=4, C4=6; T1=6, T2=8, T3=12, T4=24; T=D): ",
 		   ((1.0/6.0)*100.0 + (2.0/8.0)*100.0 + (4.0/12.0)*100.0 + (6.0/24.0)*100.0));
 	numServices = 4;
+    context_bind(&ctx, numServices, ex9_period, ex9_wcet, ex9_period);
     if(completion_time_feasibility(numServices, ex9_period, ex9_wcet, ex9_period) == TRUE)
         printf("\nCompletion Time Test FEASIBLE\n");
     else
@@ -355,11 +422,11 @@ int main(void)
         printf("Scheduling Point Test FEASIBLE\n");
     else
         printf("Scheduling Point Test INFEASIBLE\n");
-    if(rate_monotonic_least_upper_bound(numServices, ex9_period, ex9_wcet, ex9_period) == TRUE)
+    if(context_lub_test(&ctx) == TRUE)
         printf("RM LUB FEASIBLE\n");
     else
         printf("RM LUB INFEASIBLE\n");
-    if(utilization_100_test(numServices, ex9_period, ex9_wcet) == TRUE)
+    if(context_utilization_100_test(&ctx) == TRUE)
         printf("EDF and LLF FEASIBLE\n");
     else
         printf("EDF and LLF INFEASIBLE\n");
@@ -367,7 +434,7 @@ int main(void)
 
 //EXAMPLE 6
 printf("\n");
-printf("******** Completion Test, Scheduling Point, RM LUB, and DM Quick Test Feasibility Tests for Deadline Monotonic Sched 6\n\n");
+printf("******** Completion Test, Scheduling Point, RM LUB, DM Quick Test and EDF Processor Demand Feasibility Tests for Deadline Monotonic Sched 6\n\n");
 printf("Note the DM Quick test comes from equation 3.14 in the textbook.\n\n");
 printf("Ex-6 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; D1=2, D2=3, D3=7, D4=15): ",
 		   ((1.0/2.0)*100.0 + (1.0/5.0)*100.0 + (1.0/7.0)*100.0 + (2.0/13.0)*100.0));
@@ -375,6 +442,7 @@ printf("Ex-6 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; D1=2, D
     /*Analyze as deadline monotonic in feasibility tests by passing deadline array to functions below and ordering such that
     * shortest deadline has highest priority. Functions have been modified (well one line in sp function) to accomidate.
     */
+    context_bind(&ctx, numServices, ex6_period, ex6_wcet, ex6_deadline);
     if(completion_time_feasibility(numServices, ex6_period, ex6_wcet, ex6_deadline) == TRUE)
         printf("\nCompletion Time Test FEASIBLE\n");
     else
@@ -383,7 +451,7 @@ printf("Ex-6 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; D1=2, D
         printf("Scheduling Point Test FEASIBLE\n");
     else
         printf("Scheduling Point Test INFEASIBLE\n");
-    if(rate_monotonic_least_upper_bound(numServices, ex6_period, ex6_wcet, ex6_deadline) == TRUE)
+    if(context_lub_test(&ctx) == TRUE)
         printf("RM LUB FEASIBLE\n");
     else
         printf("RM LUB INFEASIBLE\n");
@@ -391,202 +459,11 @@ printf("Ex-6 U=%4.2f%% (C1=1, C2=1, C3=1, C4=2; T1=2, T2=5, T3=7, T4=13; D1=2, D
         printf("DM Quick Test FEASIBLE\n");
     else
         printf("DM Quick Test INFEASIBLE\n");
-}
-
-
-
-int rate_monotonic_least_upper_bound(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
-{
-  double utility_sum=0.0, lub=0.0;
-  int idx;
-
-  printf("for %d, utility_sum = %lf\n", numServices, utility_sum);
-
-  // Sum the C(i) over the T(i)
-  for(idx=0; idx < numServices; idx++)
-  {
-    utility_sum += ((double)wcet[idx] / (double)period[idx]);
-    printf("for %d, wcet=%lf, period=%lf, utility_sum = %lf\n", idx, (double)wcet[idx], (double)period[idx], utility_sum);
-  }
-  printf("utility_sum = %lf\n", utility_sum);
-
-  // Compute LUB for number of services
-  lub = (double)numServices * (pow(2.0, (1.0/((double)numServices))) - 1.0);
-  printf("LUB = %lf\n", lub);
-
-  // Compare the utilty to the bound and return feasibility
-  if(utility_sum <= lub)
-	  return TRUE;
-  else
-	  return FALSE;
-}
-
-/* The completion‑time feasibility test computes the worst‑case response time
- * for each task by accounting for interference from all higher‑priority tasks.
- * We begin with an initial estimate equal to the sum of execution times for
- * the task and all higher‑priority tasks. We then iteratively add additional
- * interference based on how many times each higher‑priority task can release
- * within the current response‑time estimate. This process continues until the
- * value converges, giving the worst‑case completion time under maximum load.
- * If this final response time does not exceed the task’s deadline, the task
- * is schedulable under fixed‑priority (RM) analysis. NOTE: I had an AI revise this comment as 
- * I was getting a bit wordy but it matches my thoughts and is based on my description.
- */
-
- /* CHANGE NOTE: This function works for DM and RM as long as they are ordered correctly for the corresponding policy. 
-  * No change was needed in this function, for DM applicability, just must order as shortest deadline has the highest priority.  This is because the function simply accounts for interference from higher priority tasks, and if the order of the tasks is correct for the policy, then the function will work for either RM or DM.
-  */
- int completion_time_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
-{
-  int i, j;
-  U32_T an, anext;
-  
-  // assume feasible until we find otherwise
-  int set_feasible=TRUE;
-   
-  //printf("numServices=%d\n", numServices);
- 
-  // For all services in the analysis - why the double loop?
-  for (i=0; i < numServices; i++)
-  {
-       an=0; anext=0;
-       
-       for (j=0; j <= i; j++)
-       {
-           an+=wcet[j];
-       }
-       
-	   //printf("i=%d, an=%d\n", i, an);
-
-       while(1)
-       {
-             anext=wcet[i];
-	     
-             for (j=0; j < i; j++)
-                 anext += ceil(((double)an)/((double)period[j]))*wcet[j];
-		 
-             if (anext == an)
-                break;
-             else
-                an=anext;
-
-			 //printf("an=%d, anext=%d\n", an, anext);
-       }
-       
-	   //printf("an=%d, deadline[%d]=%d\n", an, i, deadline[i]);
-
-       if (an > deadline[i])
-       {
-          set_feasible=FALSE;
-       }
-  }
-  
-  return set_feasible;
-}
-
-/* To the best of my knowledge... The scheduling‑point feasibility test examines all critical instants, which occur at multiples of higher‑priority task periods, up to the
- * period of the task being analyzed. At each such time t, the test checks whether the processor can supply enough CPU time to handle all jobs
- * released by tasks of equal or higher priority. The right side of the inequality is the available CPU time t, while the left side is the sum
- * of each higher‑priority task’s execution time multiplied by the number of times it can release within that window. If demand is less than or
- * equal to supply at any scheduling point, the task is feasible; if not, the task set is infeasible under fixed‑priority scheduling.
- */
-
- /* CHANGE NOTE: This function works for RM and DM policy as long as the services are ordered correctly for the policy in use.
- *  This is shortest period for RM and shortest deadline for DM. The only modification to the function was on line 410, note there. 
- */
-int scheduling_point_feasibility(U32_T numServices, U32_T period[], 
-				 U32_T wcet[], U32_T deadline[])
-{
-   int rc = TRUE, i, j, k, l, status, temp;
-
-   // For all services in the analysis
-   for (i=0; i < numServices; i++) // iterate from highest to lowest priority
-   {
-      status=0;
-
-      // Look for all available CPU minus what has been used by higher priority services
-      for (k=0; k<=i; k++) 
-      {
-	  // find available CPU windows and take them
-      // all I must change here is from period to deadline to ensure all higher priotity interfering tasks still
-      // allow for completion of the task under test before the task's deadline instead of its period.
-          for (l=1; l <= (floor((double)deadline[i]/(double)period[k])); l++)
-          {
-               temp=0;
-
-               for (j=0; j<=i; j++) temp += wcet[j] * ceil((double)l*(double)period[k]/(double)period[j]);
-
-	       // Can we get the CPU we need or not?
-               if (temp <= (l*period[k]))
-			   {
-				   // insufficient CPU during our period, therefore infeasible
-				   status=1;
-				   break;
-			   }
-           }
-           if (status) break;
-      }
-
-      if (!status) rc=FALSE;
-   }
-   return rc;
-}
-
-/*This is a simple function to compare utilization against 100%. For dynamic priority algorithms such as EDF and LLF,
-* this is a necessary and sufficient condition for feasibility. If under 100% utilization, the system is feasible using a
-* EDF or LLF shceduler. If over 100% the schedule is infeasible.
-*/
-int utilization_100_test(U32_T numServices, U32_T period[], U32_T wcet[]){
-    
-    double utility_sum=0.0;
-    int idx;
-
-    // Sum the C(i) over the T(i) for all services
-    for(idx=0; idx < numServices; idx++)
-    {
-        utility_sum += ((double)wcet[idx] / (double)period[idx]);
-    }
-
-    // Compare the utilty to 1.0 and return feasibility if under this value
-    if(utility_sum <= 1.0)
-        return TRUE;
+    // unlike the 100% utilization test, processor demand analysis is exact for EDF with D!=T
+    if(edf_demand_feasibility(numServices, ex6_period, ex6_wcet, ex6_deadline) == TRUE)
+        printf("EDF Processor Demand (QPA) FEASIBLE\n");
     else
-        return FALSE;
-}
-/* This function below implements equation 3.14 from the textbook and is a sufficient test to prove that the deadline monotonic
-*  schedule is feasible. It is only sufficient like the LUB and is not necessary (i.e. proves will work but fails to prove will not work).
-*  I was a little unclear on our reqs so I modified the feasibility tests as noted in them, and added this as well. I had a small error an 
-*  AI helped me find and fix since I was a bit tired, but I understand the test and it is based on the same principle as the completion time test, but with a different 
-*  equation. It accounts for interference from higher priority tasks, but instead of iteratively computing the response time, it simply computes 
-*  the demand over the deadline interval and compares it to 1.0.
-*/
-int dm_quick_test(U32_T numServices, U32_T wcet[], U32_T period[], U32_T deadline[])
-{
-    for (int i = 0; i < numServices; i++)
-    {
-        double Ci = (double)wcet[i];
-        double Di = (double)deadline[i];
-
-        // compute interference from all higher‑priority tasks
-        double Ii = 0.0;
-
-        for (int hp = 0; hp < i; hp++)
-        {
-            double Tj = (double)period[hp];
-            double Cj = (double)wcet[hp];
-
-            // number of releases of task hp inside window Di
-            double nj = ceil(Di / Tj);
+        printf("EDF Processor Demand (QPA) INFEASIBLE\n");
 
-            Ii += nj * Cj;
-        }
-
-        // normalized demand test
-        double lhs = (Ci + Ii) / Di;
-
-        if (lhs > 1.0)
-            return FALSE;   // fails sufficient test
-    }
-
-    return TRUE;            // passes sufficient test
-}
\ No newline at end of file
+    context_free(&ctx);
+}
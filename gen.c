@@ -0,0 +1,208 @@
+// Seeded random task set generator - see gen.h
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gen.h"
+
+static inline U64_T splitmix64(U64_T *x)
+{
+    U64_T z = (*x += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline U64_T rotl(U64_T x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+void gen_seed(gen_rng_t *rng, U64_T seed)
+{
+    int idx;
+
+    for(idx=0; idx < 4; idx++)
+        rng->s[idx] = splitmix64(&seed);
+}
+
+U64_T gen_next(gen_rng_t *rng)
+{
+    U64_T *s = rng->s, result = rotl(s[1] * 5, 7) * 9, t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+// Uniform in [0, 1) with the full 53 bits of a double
+double gen_uniform(gen_rng_t *rng)
+{
+    return (double)(gen_next(rng) >> 11) * 0x1.0p-53;
+}
+
+void gen_default_params(gen_params_t *params)
+{
+    memset(params, 0, sizeof(*params));
+    params->numSets = 1000;
+    params->seed = 1;
+    params->numServices = 10;
+    params->utilization = 0.7;
+    params->minPeriod = 10;
+    params->maxPeriod = 100000;
+    params->granularity = 1;
+    params->minDeadlineRatio = 1.0;
+    params->maxDeadlineRatio = 1.0;
+    params->maxTries = 1000;
+}
+
+static int parse_number(const char *value, double minimum, double maximum, double *out)
+{
+    char *end;
+
+    errno = 0;
+    *out = strtod(value, &end);
+    return !(errno || end == value || (*end && *end != ',') || !(*out >= minimum && *out <= maximum));
+}
+
+/* Update params from a comma separated list of key=value settings, for example "sets=10000,n=20,u=0.9,tmin=100,tmax=1000000".
+ * The keys are sets, seed, n, u, tmin, tmax, g (period granularity), dmin and dmax (deadline ratios) and discard (0 or 1).
+ * Returns FALSE with error set for an unknown key or a bad or inconsistent value.
+ */
+int gen_parse_params(const char *spec, gen_params_t *params, const char **error)
+{
+    static const struct { const char *key; double minimum, maximum; } keys[] =
+    {
+        {"sets", 0, 1e18}, {"seed", 0, 1.8e19}, {"n", 1, 1e7}, {"u", 0, 1e7}, {"tmin", 1, 4294967295.0},
+        {"tmax", 1, 4294967295.0}, {"g", 1, 4294967295.0}, {"dmin", 0, 1e6}, {"dmax", 0, 1e6}, {"discard", 0, 1},
+    };
+    const char *p = spec, *eq;
+    double value;
+    size_t len;
+    int idx;
+
+    while(*p)
+    {
+        if((eq = strchr(p, '=')) == NULL)
+        {
+            *error = "expected key=value";
+            return FALSE;
+        }
+        len = eq - p;
+        for(idx=0; idx < (int)(sizeof(keys)/sizeof(keys[0])); idx++)
+            if(strlen(keys[idx].key) == len && strncmp(p, keys[idx].key, len) == 0)
+                break;
+        if(idx == (int)(sizeof(keys)/sizeof(keys[0])))
+        {
+            *error = "unknown generator key";
+            return FALSE;
+        }
+        if(!parse_number(eq + 1, keys[idx].minimum, keys[idx].maximum, &value))
+        {
+            *error = "bad generator value";
+            return FALSE;
+        }
+
+        switch(idx)
+        {
+            case 0: params->numSets = (U64_T)value; break;
+            case 1: params->seed = strtoull(eq + 1, NULL, 10); break;     // exact for any 64-bit seed
+            case 2: params->numServices = (U32_T)value; break;
+            case 3: params->utilization = value; break;
+            case 4: params->minPeriod = (U32_T)value; break;
+            case 5: params->maxPeriod = (U32_T)value; break;
+            case 6: params->granularity = (U32_T)value; break;
+            case 7: params->minDeadlineRatio = value; break;
+            case 8: params->maxDeadlineRatio = value; break;
+            case 9: params->discard = (value != 0); break;
+        }
+
+        p = eq + 1 + strcspn(eq + 1, ",");
+        if(*p == ',')
+            p++;
+    }
+
+    if(params->minPeriod > params->maxPeriod || params->minDeadlineRatio > params->maxDeadlineRatio)
+    {
+        *error = "generator minimum above maximum";
+        return FALSE;
+    }
+    if(params->granularity > params->maxPeriod)
+    {
+        *error = "period granularity above the maximum period";
+        return FALSE;
+    }
+    if(!params->discard && params->utilization > 1.0 && params->numServices > 1)
+    {
+        *error = "utilization above 1 needs discard=1";
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Generate set number setIndex of the run described by params into the arrays, which must hold params->numServices entries.
+ * Returns FALSE if UUniFast-Discard could not find a split with every service at or below 100% in maxTries draws.
+ */
+int gen_task_set(const gen_params_t *params, U64_T setIndex, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    U32_T n = params->numServices, idx, tries = 0, g = params->granularity ? params->granularity : 1;
+    double sumU, nextU, u, logMin, logMax, t, c, d;
+    gen_rng_t rng;
+
+    gen_seed(&rng, params->seed ^ (setIndex * 0xD1B54A32D192ED03ULL));
+
+    logMin = log((double)params->minPeriod);
+    logMax = log((double)params->maxPeriod + 1.0);
+
+    for(;;)
+    {
+        sumU = params->utilization;
+        for(idx=0; idx < n; idx++)
+        {
+            // UUniFast: the remaining utilization of the n-idx-1 services after this one
+            nextU = (idx+1 < n) ? sumU * pow(gen_uniform(&rng), 1.0 / (double)(n - idx - 1)) : 0.0;
+            u = sumU - nextU;
+            sumU = nextU;
+            if(u > 1.0 && params->discard)
+                break;
+
+            t = floor(exp(logMin + (logMax - logMin) * gen_uniform(&rng)));
+            if(t > (double)params->maxPeriod)
+                t = (double)params->maxPeriod;
+            t = floor(t / g) * g;
+            if(t < (double)g)
+                t = (double)g;
+
+            // rounding up or down at random, in proportion, keeps the expected utilization at u(i)
+            c = floor(u * t + gen_uniform(&rng));
+            if(c < 1.0)
+                c = 1.0;
+            if(c > 4294967295.0)
+                c = 4294967295.0;
+
+            d = floor(t * (params->minDeadlineRatio + (params->maxDeadlineRatio - params->minDeadlineRatio) *
+                           gen_uniform(&rng)) + 0.5);
+            if(d < c)
+                d = c;
+            if(d > 4294967295.0)
+                d = 4294967295.0;
+
+            period[idx] = (U32_T)t;
+            wcet[idx] = (U32_T)c;
+            deadline[idx] = (U32_T)d;
+        }
+
+        if(idx == n)
+            return TRUE;
+        if(++tries >= params->maxTries)
+            return FALSE;
+    }
+}
@@ -0,0 +1,51 @@
+// Seeded random task set generator
+//
+// Produces task sets with a chosen total utilization for benchmarking and sweeps:
+//
+//  - the utilization U is split over the n services by UUniFast (Bini and Buttazzo, "Measuring the performance of schedulability
+//    tests", Real-Time Systems 30, 2005), which is uniform over the valid splits; UUniFast-Discard (Davis and Burns, 2009)
+//    redraws any split with a service above 100%, which is needed for the U > 1 sets of multicore experiments
+//  - periods are log-uniform in [minPeriod, maxPeriod], rounded down to a multiple of the granularity, so every order of
+//    magnitude is equally represented
+//  - C(i) = u(i)*T(i) rounded up or down at random in proportion to the fraction, so the expected utilization is U, but C(i) is
+//    at least 1, which raises the utilization of sets with many services on short periods
+//  - D(i) = r*T(i) rounded, with r uniform in [minDeadlineRatio, maxDeadlineRatio] and D(i) kept between C(i) and 2^32-1
+//
+// A set is a pure function of the seed and its index, so any set of a run can be regenerated on its own and the sets can be
+// generated in any order or on any thread.  The generator writes straight into the caller's arrays and never allocates.
+
+#ifndef GEN_H
+#define GEN_H
+
+#include "feasibility.h"
+
+// xoshiro256** state, seeded through splitmix64
+typedef struct
+{
+    U64_T s[4];
+} gen_rng_t;
+
+typedef struct
+{
+    U64_T numSets;              // sets in a run, for the drivers
+    U64_T seed;
+    U32_T numServices;
+    double utilization;
+    U32_T minPeriod;
+    U32_T maxPeriod;
+    U32_T granularity;          // periods are multiples of this
+    double minDeadlineRatio;
+    double maxDeadlineRatio;
+    int discard;                // UUniFast-Discard rather than plain UUniFast
+    U32_T maxTries;             // discard redraws before giving up
+} gen_params_t;
+
+void gen_seed(gen_rng_t *rng, U64_T seed);
+U64_T gen_next(gen_rng_t *rng);
+double gen_uniform(gen_rng_t *rng);
+
+void gen_default_params(gen_params_t *params);
+int gen_parse_params(const char *spec, gen_params_t *params, const char **error);
+int gen_task_set(const gen_params_t *params, U64_T setIndex, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+#endif
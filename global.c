@@ -0,0 +1,231 @@
+// Global multicore fixed priority and EDF analysis - see global.h
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "global.h"
+#include "rta.h"
+
+// Per-thread response time bounds and working estimates, grown as needed and reused from one call to the next
+static __thread U64_T *global_bound = NULL, *global_work = NULL;
+static __thread U32_T global_capacity = 0;
+
+static int global_reserve(U32_T count)
+{
+    U64_T *p;
+
+    if(count <= global_capacity)
+        return TRUE;
+
+    if((p = realloc(global_bound, count * sizeof(U64_T))) == NULL) return FALSE;
+    global_bound = p;
+    if((p = realloc(global_work, count * sizeof(U64_T))) == NULL) return FALSE;
+    global_work = p;
+
+    global_capacity = count;
+    return TRUE;
+}
+
+static inline U64_T min_u64(U64_T a, U64_T b)
+{
+    return (a < b) ? a : b;
+}
+
+// The deadline the analysis uses, no longer than the period
+static inline U64_T global_deadline(const U32_T period[], const U32_T deadline[], U32_T i)
+{
+    return (deadline[i] < period[i]) ? deadline[i] : period[i];
+}
+
+// Work of a service in a window of length x that no job of it was released before: floor(x/T)*C + min(x mod T, C)
+static inline U64_T global_workload_nc(U64_T x, U64_T T, U64_T C)
+{
+    return (x / T) * C + min_u64(x % T, C);
+}
+
+/* Work of a service in a window of length x that starts with a job carried in, which completes within response time R: the
+ * carried in job runs C at the start of the window and the rest of the jobs follow as early as they can.
+ */
+static inline U64_T global_workload_ci(U64_T x, U64_T T, U64_T C, U64_T R)
+{
+    U64_T y = (x > C) ? x - C : 0, rest = y % T, alpha = 0;
+
+    if(C == 0)
+        return 0;
+    if(rest > T - R)
+        alpha = min_u64(rest - (T - R), C - 1);
+    return (y / T) * C + C + alpha;
+}
+
+/* Omega(k)(x) for global fixed priority: the no carry-in interference of every higher priority service plus the m-1 largest
+ * excesses of its carry-in interference over that, with each interference capped at x - C(k) + 1.  top[] holds the largest
+ * excesses found so far in increasing order.
+ */
+static U64_T global_fp_interference(U32_T k, U32_T numCores, const U32_T period[], const U32_T wcet[], const U64_T bound[],
+                                    U64_T x, U64_T top[])
+{
+    U64_T cap = x - wcet[k] + 1, sum = 0, nc, ci, diff;
+    U32_T i, pos, numTop = 0, slots = (numCores - 1 < k) ? numCores - 1 : k;
+
+    FEASIBILITY_COUNT(iterations, 1);
+    FEASIBILITY_COUNT(divisions, 2*k);
+    for(i=0; i < k; i++)
+    {
+        nc = min_u64(global_workload_nc(x, period[i], wcet[i]), cap);
+        ci = min_u64(global_workload_ci(x, period[i], wcet[i], bound[i]), cap);
+        sum += nc;
+        if(ci <= nc || slots == 0)
+            continue;
+
+        diff = ci - nc;
+        if(numTop < slots)
+        {
+            for(pos=numTop++; pos > 0 && top[pos-1] > diff; pos--)
+                top[pos] = top[pos-1];
+        }
+        else if(diff > top[0])
+        {
+            for(pos=0; pos+1 < numTop && top[pos+1] < diff; pos++)
+                top[pos] = top[pos+1];
+        }
+        else
+            continue;
+        top[pos] = diff;
+    }
+
+    for(pos=0; pos < numTop; pos++)
+        sum += top[pos];
+    return sum;
+}
+
+int global_fp_response_times(U32_T numServices, U32_T numCores, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                             U64_T response[])
+{
+    U64_T x, next, limit;
+    int set_feasible = (numCores > 0);
+    U32_T k;
+
+    if(!global_reserve(numServices ? numServices : 1))
+        return -1;
+
+    // the bound of each service needs those of the services above it, so the analysis ends at the first one not found
+    for(k=0; k < numServices; k++)
+    {
+        limit = global_deadline(period, deadline, k);
+        x = wcet[k];
+        while(set_feasible && x <= limit)
+        {
+            next = wcet[k] + global_fp_interference(k, numCores, period, wcet, global_bound, x, global_work) / numCores;
+            if(next == x)
+                break;
+            x = next;
+        }
+
+        if(!set_feasible || x > limit)
+        {
+            set_feasible = FALSE;
+            x = RTA_RESPONSE_UNKNOWN;
+        }
+        global_bound[k] = x;
+    }
+
+    if(response)
+        memcpy(response, global_bound, numServices * sizeof(U64_T));
+    return set_feasible;
+}
+
+/* Omega(k)(x) for global EDF: the interference of every other service, bounded by its workload in a window of length x, by the
+ * work of its jobs that have deadlines within service k's deadline, and by x - C(k) + 1.  Both workload bounds place the last
+ * job of service i to complete as late as its response time bound allows.
+ */
+static U64_T global_edf_interference(U32_T numServices, U32_T k, const U32_T period[], const U32_T wcet[],
+                                     const U32_T deadline[], const U64_T bound[], U64_T x)
+{
+    U64_T cap = x - wcet[k] + 1, Dk = global_deadline(period, deadline, k), sum = 0, T, C, span, jobs, work, edfWork, slack;
+    U32_T i;
+
+    FEASIBILITY_COUNT(iterations, 1);
+    FEASIBILITY_COUNT(divisions, 2*(numServices - 1));
+    for(i=0; i < numServices; i++)
+    {
+        if(i == k)
+            continue;
+        T = period[i];
+        C = wcet[i];
+
+        span = x + bound[i] - C;
+        jobs = span / T;
+        work = jobs * C + min_u64(C, span - jobs * T);
+
+        slack = global_deadline(period, deadline, i) - bound[i];
+        edfWork = (Dk / T) * C + ((Dk % T > slack) ? min_u64(C, Dk % T - slack) : 0);
+
+        sum += min_u64(min_u64(work, edfWork), cap);
+    }
+
+    return sum;
+}
+
+int global_edf_response_times(U32_T numServices, U32_T numCores, const U32_T period[], const U32_T wcet[],
+                              const U32_T deadline[], U64_T response[])
+{
+    U64_T x, next, limit;
+    int allMet = FALSE, improved = TRUE;
+    U32_T k, round;
+
+    if(!global_reserve(numServices ? numServices : 1))
+        return -1;
+
+    // with no slack known every service is assumed to respond at its deadline
+    for(k=0; k < numServices; k++)
+    {
+        // a longer deadline would change the EDF priorities the bounds rely on, so such a set is not analyzed
+        if(deadline[k] > period[k] && numCores > 0)
+        {
+            for(k=0; response && k < numServices; k++)
+                response[k] = RTA_RESPONSE_UNKNOWN;
+            return FALSE;
+        }
+
+        global_bound[k] = global_deadline(period, deadline, k);
+        global_work[k] = RTA_RESPONSE_UNKNOWN;
+    }
+
+    for(round=0; numCores > 0 && improved && !allMet && round < GLOBAL_EDF_ROUNDS; round++)
+    {
+        allMet = TRUE;
+        improved = FALSE;
+        for(k=0; k < numServices; k++)
+        {
+            limit = global_bound[k];
+            x = wcet[k];
+            while(x <= limit)
+            {
+                next = wcet[k] + global_edf_interference(numServices, k, period, wcet, deadline, global_bound, x) / numCores;
+                if(next == x)
+                    break;
+                x = next;
+            }
+
+            // a bound found replaces the assumed one at once, so the services after it see the extra slack this round
+            if(x <= limit)
+            {
+                global_work[k] = x;
+                if(x < global_bound[k])
+                {
+                    global_bound[k] = x;
+                    improved = TRUE;
+                }
+            }
+            else
+            {
+                global_work[k] = RTA_RESPONSE_UNKNOWN;
+                allMet = FALSE;
+            }
+        }
+    }
+
+    if(response)
+        memcpy(response, global_work, numServices * sizeof(U64_T));
+    return allMet && numCores > 0;
+}
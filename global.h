@@ -0,0 +1,40 @@
+// Global multicore fixed priority and EDF analysis
+//
+// Under global scheduling every core takes the highest priority ready jobs of one shared queue, so a service can migrate and no
+// partition has to be found, but the uniprocessor tests no longer apply: the worst case is not the synchronous release, and
+// global RM or EDF can miss deadlines at a utilization just above 1 on any number of cores (Dhall and Liu's effect).  These are
+// the sufficient response time tests of Bertogna and Cirinei, iterated to a fixed point like the completion test.  Service k of
+// a set on m cores responds within the smallest
+//
+//     R(k) = C(k) + floor(Omega(k)(R(k)) / m)
+//
+// where Omega(k)(x) bounds the work of the other services that can keep all m cores busy while service k is ready, each of them
+// counted up to x - C(k) + 1.
+//
+//     global_fp_response_times   global fixed priority in array order with the limited carry-in bound of Guan, Stigge, Yi and
+//                                Yu (RTA-LC): at most m-1 higher priority services have a job carried in from before the
+//                                window, so Omega adds the carry-in excess of only the m-1 largest to the workload without it
+//     global_edf_response_times  global EDF, where each other service's workload is also bounded by what it can release with a
+//                                deadline before service k's (Bertogna, Cirinei and Lipari).  Both bounds shrink with the other
+//                                services' slack D(i) - R(i), so the response times start at the deadlines and are recomputed
+//                                in rounds until none improves
+//
+// The analysis assumes constrained deadlines.  Under fixed priority a deadline beyond the period is analyzed as D = T, which keeps
+// the result safe; under EDF the deadlines also set the priorities, so a set with one is reported not schedulable.
+// Both return TRUE when every response time bound is within its deadline, FALSE otherwise and -1 if memory ran out.  response[]
+// may be NULL; it receives the bound of each service, or RTA_RESPONSE_UNKNOWN where none within the deadline was found.
+
+#ifndef GLOBAL_H
+#define GLOBAL_H
+
+#include "feasibility.h"
+
+// Most rounds of slack updates for global EDF; a test that needs more gives up on the services still missing
+#define GLOBAL_EDF_ROUNDS 64
+
+int global_fp_response_times(U32_T numServices, U32_T numCores, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                             U64_T response[]);
+int global_edf_response_times(U32_T numServices, U32_T numCores, const U32_T period[], const U32_T wcet[],
+                              const U32_T deadline[], U64_T response[]);
+
+#endif
@@ -0,0 +1,177 @@
+// Mixed criticality fixed priority analysis (adaptive mixed criticality, AMC) - see mixedcrit.h
+
+#include <stdlib.h>
+
+#include "mixedcrit.h"
+#include "rta.h"
+
+// Per-thread list of the HI criticality services above the one analyzed, in priority order, reused from one call to the next
+static __thread U32_T *mc_order = NULL;
+static __thread U32_T mc_capacity = 0;
+
+static int mc_reserve(U32_T count)
+{
+    U32_T *p;
+
+    if(count <= mc_capacity)
+        return TRUE;
+
+    if((p = realloc(mc_order, count * sizeof(U32_T))) == NULL)
+        return FALSE;
+    mc_order = p;
+    mc_capacity = count;
+    return TRUE;
+}
+
+static inline U64_T ceil_div(U64_T a, U64_T b)
+{
+    return a / b + (a % b != 0);
+}
+
+static inline U64_T min_u64(U64_T a, U64_T b)
+{
+    return (a < b) ? a : b;
+}
+
+/* Work of the LO criticality services above service i released up to window, counted as count(k) jobs each: ceil(window/T(k))
+ * for AMC-rtb, which passes R(i,LO), and floor(window/T(k)) + 1 for AMC-max, which passes the switch time.  Returns FALSE once
+ * the work passes limit.
+ */
+static int mc_lo_work(U32_T i, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[], U64_T window, int atSwitch,
+                      U64_T limit, U64_T *work)
+{
+    U64_T sum = 0;
+    U32_T k;
+
+    FEASIBILITY_COUNT(divisions, i);
+    for(k=0; k < i; k++)
+    {
+        if(wcetHi[k])
+            continue;
+        sum += (atSwitch ? window / period[k] + 1 : ceil_div(window, period[k])) * wcetLo[k];
+        if(sum > limit)
+            return FALSE;
+    }
+
+    *work = sum;
+    return TRUE;
+}
+
+/* R(s) of AMC-max for a HI criticality service below the numHi services of mc_order with the mode switch at s, where base is
+ * its C(HI) plus the LO criticality work released up to s.  The estimate only grows, so FALSE is returned as soon as it passes
+ * limit.
+ */
+static int mc_max_fixed_point(const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[], const U32_T deadline[],
+                              U32_T numHi, U64_T s, U64_T base, U64_T limit, U64_T *response)
+{
+    U64_T w = base, next, jobs, hiJobs, offset, Dj, term;
+    U32_T h, j;
+
+    for(h=0; h < numHi; h++)
+        w += wcetHi[mc_order[h]];
+
+    while(w <= limit)
+    {
+        FEASIBILITY_COUNT(iterations, 1);
+        FEASIBILITY_COUNT(divisions, 2*numHi);
+        next = base;
+        for(h=0; h < numHi && next <= limit; h++)
+        {
+            j = mc_order[h];
+            Dj = min_u64(deadline[j], period[j]);
+            jobs = ceil_div(w, period[j]);
+
+            // the jobs of j with deadlines after the switch may run to their HI WCET, the first of them whatever its release
+            offset = s + (period[j] - Dj);
+            hiJobs = (w > offset) ? min_u64(ceil_div(w - offset, period[j]) + 1, jobs) : min_u64(1, jobs);
+
+            term = hiJobs * wcetHi[j] + (jobs - hiJobs) * wcetLo[j];
+            if(__builtin_add_overflow(next, term, &next))
+                return FALSE;
+        }
+
+        if(next == w)
+        {
+            *response = w;
+            return TRUE;
+        }
+        w = next;
+    }
+
+    return FALSE;
+}
+
+static int mc_response_times(U32_T numServices, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[],
+                             const U32_T deadline[], int amcMax, U64_T responseLo[], U64_T responseHi[])
+{
+    U64_T limit, lo, hi, r, work, s, next, release;
+    int set_feasible = TRUE;
+    U32_T i, k, numHi = 0;
+
+    if(!mc_reserve(numServices ? numServices : 1))
+        return -1;
+
+    for(i=0; i < numServices; i++)
+    {
+        limit = min_u64(deadline[i], period[i]);
+
+        // LO mode, where every service runs to its LO WCET
+        if(!rta_response_time(i, period, wcetLo, 0, limit, &lo))
+            lo = RTA_RESPONSE_UNKNOWN;
+        hi = 0;
+
+        if(wcetHi[i] && lo == RTA_RESPONSE_UNKNOWN)
+            hi = RTA_RESPONSE_UNKNOWN;
+        else if(wcetHi[i] && !amcMax)
+        {
+            // the LO services interfere up to the switch, which is at the latest R(i,LO); R* >= R(i,LO) seeds the fixed point
+            if(!mc_lo_work(i, period, wcetLo, wcetHi, lo, FALSE, limit, &work) ||
+               !rta_response_time_base(numHi, mc_order, period, wcetHi, wcetHi[i] + work, lo, limit, &hi))
+                hi = RTA_RESPONSE_UNKNOWN;
+        }
+        else if(wcetHi[i])
+        {
+            // every release of a LO service before R(i,LO) is a candidate switch time, starting with the critical instant
+            for(s=0; (s == 0 || s < lo) && hi != RTA_RESPONSE_UNKNOWN; s=next)
+            {
+                if(!mc_lo_work(i, period, wcetLo, wcetHi, s, TRUE, limit, &work) ||
+                   !mc_max_fixed_point(period, wcetLo, wcetHi, deadline, numHi, s, wcetHi[i] + work, limit, &r))
+                    hi = RTA_RESPONSE_UNKNOWN;
+                else if(r > hi)
+                    hi = r;
+
+                next = RTA_RESPONSE_UNKNOWN;
+                for(k=0; k < i; k++)
+                {
+                    release = (s / period[k] + 1) * period[k];
+                    if(!wcetHi[k] && release < next)
+                        next = release;
+                }
+            }
+        }
+
+        if(lo == RTA_RESPONSE_UNKNOWN || hi == RTA_RESPONSE_UNKNOWN)
+            set_feasible = FALSE;
+        if(responseLo)
+            responseLo[i] = lo;
+        if(responseHi)
+            responseHi[i] = hi;
+
+        if(wcetHi[i])
+            mc_order[numHi++] = i;
+    }
+
+    return set_feasible;
+}
+
+int amc_rtb_response_times(U32_T numServices, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[],
+                           const U32_T deadline[], U64_T responseLo[], U64_T responseHi[])
+{
+    return mc_response_times(numServices, period, wcetLo, wcetHi, deadline, FALSE, responseLo, responseHi);
+}
+
+int amc_max_response_times(U32_T numServices, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[],
+                           const U32_T deadline[], U64_T responseLo[], U64_T responseHi[])
+{
+    return mc_response_times(numServices, period, wcetLo, wcetHi, deadline, TRUE, responseLo, responseHi);
+}
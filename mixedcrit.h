@@ -0,0 +1,40 @@
+// Mixed criticality fixed priority analysis (adaptive mixed criticality, AMC)
+//
+// Each service has a LO and a HI criticality WCET, C(LO) <= C(HI); a LO criticality service has only C(LO).  The system runs in
+// LO mode until a HI criticality job executes for its C(LO) without completing.  It then switches to HI mode, where the LO
+// criticality services are no longer released, and only the HI criticality services keep their deadline guarantee.  Priorities
+// are the array order, as for the completion test.
+//
+// The LO mode response times are the completion test's with the LO WCETs.  Across the mode switch, the two bounds of Baruah,
+// Burns and Davis for a HI criticality service i are:
+//
+//     amc_rtb_response_times  R*(i) = C(i,HI) + sum over HI j < i of ceil(R*(i)/T(j)) * C(j,HI)
+//                                             + sum over LO k < i of ceil(R(i,LO)/T(k)) * C(k,LO)
+//                             since the LO services can only interfere until the switch, which is no later than R(i,LO)
+//     amc_max_response_times  the largest R(s) over the switch times s, the releases of the LO services before R(i,LO):
+//                             R(s) = C(i,HI) + sum over LO k < i of (floor(s/T(k)) + 1) * C(k,LO)
+//                                    + sum over HI j < i of M(j,s,R(s)) * C(j,HI) + (ceil(R(s)/T(j)) - M(j,s,R(s))) * C(j,LO)
+//                             where M(j,s,t) = min(ceil((t - s - (T(j) - D(j)))/T(j)) + 1, ceil(t/T(j))) is the most jobs of
+//                             j that can run in HI mode, with the first term taken as at least 1
+//
+// AMC-max dominates AMC-rtb, which in turn accepts every set that the completion test accepts with each HI criticality service
+// at its HI WCET (the over-provisioned single criticality view).  R*(i) is found with the completion test fixed point over
+// the HI higher priority services, seeded from R(i,LO).
+//
+// The analysis assumes constrained deadlines, and a deadline beyond the period is analyzed as D = T, which keeps the result safe.
+// wcetHi[i] is the HI WCET of a HI criticality service and 0 for a LO criticality one.  Both return TRUE when every service
+// meets its deadline in LO mode and every HI criticality service across the switch, FALSE otherwise and -1 if memory ran out.
+// responseLo[] and responseHi[] may be NULL; they receive the bounds, RTA_RESPONSE_UNKNOWN where none within the deadline was
+// found, with responseHi 0 for the LO criticality services.
+
+#ifndef MIXEDCRIT_H
+#define MIXEDCRIT_H
+
+#include "feasibility.h"
+
+int amc_rtb_response_times(U32_T numServices, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[],
+                           const U32_T deadline[], U64_T responseLo[], U64_T responseHi[]);
+int amc_max_response_times(U32_T numServices, const U32_T period[], const U32_T wcetLo[], const U32_T wcetHi[],
+                           const U32_T deadline[], U64_T responseLo[], U64_T responseHi[]);
+
+#endif
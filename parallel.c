@@ -0,0 +1,172 @@
+// Work stealing parallel loop - see parallel.h
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "parallel.h"
+
+// One worker's remaining range [next, end), on its own cache line since the owner updates it for every piece it takes
+typedef struct
+{
+    pthread_mutex_t lock;
+    U64_T next;
+    U64_T end;
+    pthread_t thread;
+    struct parallel_pool *pool;
+    U32_T index;
+} __attribute__((aligned(64))) parallel_worker_t;
+
+typedef struct parallel_pool
+{
+    parallel_worker_t *workers;
+    U32_T numWorkers;
+    U64_T grain;
+    parallel_range_fn fn;
+    void *context;
+} parallel_pool_t;
+
+U32_T parallel_default_workers(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (n > 0) ? (U32_T)n : 1;
+}
+
+/* Move the back half of the largest remaining range (all of it when it is no more than one piece) to worker self.  The scan for
+ * the victim reads the other ranges without locking, so it is only a hint and is checked again under the victim's lock.
+ * Returns FALSE when there is nothing left anywhere.
+ */
+static int parallel_steal(parallel_pool_t *pool, parallel_worker_t *self)
+{
+    parallel_worker_t *victim;
+    U64_T remaining, best, take, next, end;
+    U32_T idx, v;
+
+    for(;;)
+    {
+        best = 0;
+        v = 0;
+        for(idx=0; idx < pool->numWorkers; idx++)
+        {
+            victim = &pool->workers[idx];
+            next = __atomic_load_n(&victim->next, __ATOMIC_RELAXED);
+            end = __atomic_load_n(&victim->end, __ATOMIC_RELAXED);
+            remaining = (end > next) ? end - next : 0;
+            if(victim != self && remaining > best)
+            {
+                best = remaining;
+                v = idx;
+            }
+        }
+        if(best == 0)
+            return FALSE;
+
+        victim = &pool->workers[v];
+        pthread_mutex_lock(&victim->lock);
+        remaining = victim->end - victim->next;
+        if(remaining == 0)
+        {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        take = (remaining > pool->grain) ? remaining / 2 : remaining;
+        end = victim->end;
+        __atomic_store_n(&victim->end, end - take, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&victim->lock);
+
+        pthread_mutex_lock(&self->lock);
+        __atomic_store_n(&self->next, end - take, __ATOMIC_RELAXED);
+        __atomic_store_n(&self->end, end, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&self->lock);
+        return TRUE;
+    }
+}
+
+static void *parallel_worker(void *arg)
+{
+    parallel_worker_t *self = arg;
+    parallel_pool_t *pool = self->pool;
+    U64_T begin, end;
+
+    do
+    {
+        for(;;)
+        {
+            pthread_mutex_lock(&self->lock);
+            begin = self->next;
+            end = (self->end - begin > pool->grain) ? begin + pool->grain : self->end;
+            __atomic_store_n(&self->next, end, __ATOMIC_RELAXED);
+            pthread_mutex_unlock(&self->lock);
+
+            if(begin == end)
+                break;
+            pool->fn(pool->context, self->index, begin, end);
+        }
+    } while(parallel_steal(pool, self));
+
+    return NULL;
+}
+
+/* Run fn over [0, count) on numWorkers workers, the calling thread being worker 0.  When a thread cannot be started its range is
+ * simply stolen by the workers that did start, so the loop still completes.  Returns FALSE only if the worker table could not be
+ * allocated.
+ */
+int parallel_for(U64_T count, U32_T numWorkers, U64_T grain, parallel_range_fn fn, void *context)
+{
+    parallel_pool_t pool;
+    U64_T begin, end;
+    U32_T idx;
+    int *started;
+
+    if(numWorkers < 1)
+        numWorkers = 1;
+    if(grain < 1)
+        grain = 1;
+
+    if(numWorkers == 1)
+    {
+        for(begin=0; begin < count; begin = end)
+        {
+            end = (count - begin > grain) ? begin + grain : count;
+            fn(context, 0, begin, end);
+        }
+        return TRUE;
+    }
+
+    if(posix_memalign((void **)&pool.workers, 64, numWorkers * sizeof(parallel_worker_t)) != 0)
+        return FALSE;
+    if((started = calloc(numWorkers, sizeof(int))) == NULL)
+    {
+        free(pool.workers);
+        return FALSE;
+    }
+    pool.numWorkers = numWorkers;
+    pool.grain = grain;
+    pool.fn = fn;
+    pool.context = context;
+
+    for(idx=0; idx < numWorkers; idx++)
+    {
+        pthread_mutex_init(&pool.workers[idx].lock, NULL);
+        pool.workers[idx].next = count * idx / numWorkers;
+        pool.workers[idx].end = count * (idx+1) / numWorkers;
+        pool.workers[idx].pool = &pool;
+        pool.workers[idx].index = idx;
+    }
+
+    for(idx=1; idx < numWorkers; idx++)
+        started[idx] = (pthread_create(&pool.workers[idx].thread, NULL, parallel_worker, &pool.workers[idx]) == 0);
+
+    parallel_worker(&pool.workers[0]);
+
+    for(idx=1; idx < numWorkers; idx++)
+        if(started[idx])
+            pthread_join(pool.workers[idx].thread, NULL);
+
+    for(idx=0; idx < numWorkers; idx++)
+        pthread_mutex_destroy(&pool.workers[idx].lock);
+    free(started);
+    free(pool.workers);
+    return TRUE;
+}
@@ -0,0 +1,22 @@
+// Work stealing parallel loop for the batch driver
+//
+// The feasibility tests are pure functions of their input arrays (their scratch buffers are thread local), so a corpus of task
+// sets can be analyzed on every core at once.  parallel_for splits the index range [0, count) evenly across the workers, and
+// each worker takes grain sized pieces from the front of its own range.  A worker that runs out steals the back half of the
+// largest remaining range, so a shard that happens to hold slow (typically infeasible or large hyperperiod) sets is spread over
+// the idle workers rather than holding up the whole run.
+//
+// fn is called with the worker number, 0..numWorkers-1, so it can keep per-worker results without locking; the pieces a worker
+// is given are disjoint but not necessarily in order.
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "feasibility.h"
+
+typedef void (*parallel_range_fn)(void *context, U32_T worker, U64_T begin, U64_T end);
+
+U32_T parallel_default_workers(void);
+int parallel_for(U64_T count, U32_T numWorkers, U64_T grain, parallel_range_fn fn, void *context);
+
+#endif
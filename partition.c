@@ -0,0 +1,278 @@
+// Partitioned multicore fixed priority admission - see partition.h
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "partition.h"
+
+const char *partition_heuristic_names[] = {"ff", "bf", "wf"};
+
+void partition_init(partition_t *part)
+{
+    memset(part, 0, sizeof(*part));
+}
+
+void partition_free(partition_t *part)
+{
+    U32_T idx;
+
+    for(idx=0; idx < part->coreCapacity; idx++)
+        rta_state_free(&part->cores[idx]);
+    free(part->cores);
+    free(part->utilization);
+    free(part->coreOrder);
+    free(part->core);
+    free(part->sorted);
+    partition_init(part);
+}
+
+static int partition_reserve(partition_t *part, U32_T numServices, U32_T numCores)
+{
+    rta_state_t *s;
+    double *u;
+    U32_T *p, idx;
+
+    if(numServices > part->serviceCapacity)
+    {
+        if((p = realloc(part->core, numServices * sizeof(U32_T))) == NULL) return FALSE;
+        part->core = p;
+        if((p = realloc(part->sorted, numServices * sizeof(U32_T))) == NULL) return FALSE;
+        part->sorted = p;
+        part->serviceCapacity = numServices;
+    }
+
+    if(numCores > part->coreCapacity)
+    {
+        if((s = realloc(part->cores, numCores * sizeof(rta_state_t))) == NULL) return FALSE;
+        part->cores = s;
+        for(idx=part->coreCapacity; idx < numCores; idx++)
+            rta_state_init(&part->cores[idx]);
+        part->coreCapacity = numCores;
+        if((u = realloc(part->utilization, numCores * sizeof(double))) == NULL) return FALSE;
+        part->utilization = u;
+        if((p = realloc(part->coreOrder, numCores * sizeof(U32_T))) == NULL) return FALSE;
+        part->coreOrder = p;
+    }
+
+    return TRUE;
+}
+
+// TRUE when service a has a higher utilization than service b (exactly, by cross multiplication), ties by the lower index
+static inline int partition_before(const U32_T period[], const U32_T wcet[], U32_T a, U32_T b)
+{
+    U64_T ua = (U64_T)wcet[a] * period[b], ub = (U64_T)wcet[b] * period[a];
+
+    if(ua != ub)
+        return ua > ub;
+    return a < b;
+}
+
+static void partition_sift_down(U32_T sorted[], U32_T pos, U32_T count, const U32_T period[], const U32_T wcet[])
+{
+    U32_T child, tmp;
+
+    while((child = 2*pos + 1) < count)
+    {
+        if(child+1 < count && partition_before(period, wcet, sorted[child], sorted[child+1]))
+            child++;
+        if(!partition_before(period, wcet, sorted[pos], sorted[child]))
+            break;
+        tmp = sorted[pos]; sorted[pos] = sorted[child]; sorted[child] = tmp;
+        pos = child;
+    }
+}
+
+// Heapsort of the service indexes into decreasing utilization order
+static void partition_sort(U32_T numServices, U32_T sorted[], const U32_T period[], const U32_T wcet[])
+{
+    U32_T i, tmp;
+
+    for(i=0; i < numServices; i++)
+        sorted[i] = i;
+    if(numServices < 2)
+        return;
+
+    for(i=numServices/2; i-- > 0;)
+        partition_sift_down(sorted, i, numServices, period, wcet);
+
+    for(i=numServices-1; i > 0; i--)
+    {
+        tmp = sorted[0]; sorted[0] = sorted[i]; sorted[i] = tmp;
+        partition_sift_down(sorted, 0, i, period, wcet);
+    }
+}
+
+/* Position of a service with these parameters on a core, or PARTITION_UNASSIGNED.  Services that match are interchangeable, and
+ * the lowest priority one is taken, which has the longest response time of them.
+ */
+static U32_T partition_find(const rta_state_t *state, U32_T period, U32_T wcet, U32_T deadline)
+{
+    U32_T pos;
+
+    for(pos=state->numServices; pos-- > 0;)
+        if(state->period[pos] == period && state->wcet[pos] == wcet && state->deadline[pos] == deadline)
+            return pos;
+
+    return PARTITION_UNASSIGNED;
+}
+
+// TRUE when core a comes before core b in the heuristic's order: most loaded first for best fit, least loaded first for worst
+// fit, ties by the lower core number.  First fit keeps the core numbering.
+static inline int partition_core_before(const partition_t *part, U32_T a, U32_T b, int heuristic)
+{
+    double ua = part->utilization[a], ub = part->utilization[b];
+
+    if(heuristic == PARTITION_BF && ua != ub)
+        return ua > ub;
+    if(heuristic == PARTITION_WF && ua != ub)
+        return ua < ub;
+    return a < b;
+}
+
+// After the load of the core at coreOrder[pos] changed, move it to keep coreOrder sorted for the heuristic
+static void partition_reorder(partition_t *part, U32_T pos, int heuristic)
+{
+    U32_T c = part->coreOrder[pos];
+
+    for(; pos > 0 && partition_core_before(part, c, part->coreOrder[pos-1], heuristic); pos--)
+        part->coreOrder[pos] = part->coreOrder[pos-1];
+    for(; pos+1 < part->numCores && partition_core_before(part, part->coreOrder[pos+1], c, heuristic); pos++)
+        part->coreOrder[pos] = part->coreOrder[pos+1];
+    part->coreOrder[pos] = c;
+}
+
+/* Empty every core of a partition over numCores cores, so services can be placed on it one at a time.  Returns FALSE if memory
+ * ran out.
+ */
+int partition_clear(partition_t *part, U32_T numCores)
+{
+    U32_T c;
+
+    if(!partition_reserve(part, 0, numCores))
+        return FALSE;
+
+    part->numCores = numCores;
+    part->numServices = 0;
+    part->numUnassigned = 0;
+    for(c=0; c < numCores; c++)
+    {
+        rta_state_clear(&part->cores[c]);
+        part->utilization[c] = 0.0;
+        part->coreOrder[c] = c;
+    }
+
+    return TRUE;
+}
+
+/* Place one service on the first core in the heuristic's order that admits it, leaving the other cores as they were.  Returns
+ * its core, or PARTITION_UNASSIGNED when no core can take it.
+ */
+U32_T partition_place(partition_t *part, U32_T period, U32_T wcet, U32_T deadline, int heuristic)
+{
+    U32_T pos, c;
+
+    for(pos=0; pos < part->numCores; pos++)
+    {
+        c = part->coreOrder[pos];
+        if(rta_state_admit(&part->cores[c], period, wcet, deadline, NULL))
+        {
+            part->utilization[c] += (double)wcet / (double)period;
+            partition_reorder(part, pos, heuristic);
+            return c;
+        }
+    }
+
+    return PARTITION_UNASSIGNED;
+}
+
+/* Take a service placed by partition_place off its core again; the services below it on that core are updated incrementally.
+ * Returns FALSE when the core holds no service with these parameters.
+ */
+int partition_withdraw(partition_t *part, U32_T core, U32_T period, U32_T wcet, U32_T deadline, int heuristic)
+{
+    rta_state_t *state;
+    U32_T idx, pos;
+    double utility_sum = 0.0;
+
+    if(core >= part->numCores || (pos = partition_find(&part->cores[core], period, wcet, deadline)) == PARTITION_UNASSIGNED)
+        return FALSE;
+
+    state = &part->cores[core];
+    rta_state_remove(state, pos);
+
+    // summed again rather than decremented, so a long run of placements and withdrawals does not accumulate rounding
+    for(idx=0; idx < state->numServices; idx++)
+        utility_sum += (double)state->wcet[idx] / (double)state->period[idx];
+    part->utilization[core] = utility_sum;
+
+    for(pos=0; part->coreOrder[pos] != core; pos++)
+        ;
+    partition_reorder(part, pos, heuristic);
+    return TRUE;
+}
+
+// Response time of a service placed on core, or RTA_RESPONSE_UNKNOWN when the core holds no service with these parameters
+U64_T partition_response_time(const partition_t *part, U32_T core, U32_T period, U32_T wcet, U32_T deadline)
+{
+    U32_T pos;
+
+    if(core >= part->numCores || (pos = partition_find(&part->cores[core], period, wcet, deadline)) == PARTITION_UNASSIGNED)
+        return RTA_RESPONSE_UNKNOWN;
+    return part->cores[core].response[pos];
+}
+
+/* Partition the services over numCores cores with the given heuristic.  Every service is tried, so when some do not fit the
+ * result still shows where the others went.  Returns TRUE when every service was placed, FALSE when numUnassigned > 0, and -1
+ * if memory ran out.
+ */
+int partition_services(partition_t *part, U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                       U32_T numCores, int heuristic)
+{
+    U32_T idx, s;
+
+    if(!partition_reserve(part, numServices, numCores) || !partition_clear(part, numCores))
+        return -1;
+
+    part->numServices = numServices;
+    partition_sort(numServices, part->sorted, period, wcet);
+
+    for(idx=0; idx < numServices; idx++)
+    {
+        s = part->sorted[idx];
+        if((part->core[s] = partition_place(part, period[s], wcet[s], deadline[s], heuristic)) == PARTITION_UNASSIGNED)
+            part->numUnassigned++;
+    }
+
+    return (part->numUnassigned == 0);
+}
+
+/* The fewest cores the heuristic can partition the services onto, searching up from the utilization bound ceil(U).  part holds
+ * that partition afterwards.  Returns 0 when some service is infeasible even alone on a core (part then holds the attempt with
+ * one core per service), or if memory ran out.
+ */
+U32_T partition_min_cores(partition_t *part, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                          const U32_T deadline[], int heuristic)
+{
+    double utility_sum = 0.0;
+    U32_T idx, numCores;
+    int rc;
+
+    for(idx=0; idx < numServices; idx++)
+        utility_sum += (double)wcet[idx] / (double)period[idx];
+
+    // the rounding of the sum only matters for where the search starts, not for the answer
+    numCores = (U32_T)ceil(utility_sum - 1e-9);
+    if(numCores < 1)
+        numCores = 1;
+
+    for(; numCores <= (numServices ? numServices : 1); numCores++)
+    {
+        if((rc = partition_services(part, numServices, period, wcet, deadline, numCores, heuristic)) < 0)
+            return 0;
+        if(rc)
+            return numCores;
+    }
+
+    return 0;
+}
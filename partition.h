@@ -0,0 +1,62 @@
+// Partitioned multicore fixed priority admission
+//
+// Global scheduling can fail at low utilization (Dhall and Liu's effect), so the usual alternative is to pin each service to one
+// core and run an ordinary single core fixed priority scheduler per core.  Finding the best partition is bin packing, so the
+// services are placed in decreasing utilization order by one of the classic heuristics (Burchard et al., Bertossi et al.):
+//
+//     PARTITION_FF   first fit, the lowest numbered core the service fits on
+//     PARTITION_BF   best fit, the most loaded core the service fits on
+//     PARTITION_WF   worst fit, the least loaded core the service fits on
+//
+// "Fits" is decided by the exact completion test, not a utilization bound: each core keeps its services as an rta_state_t in
+// deadline monotonic order, so a placement is an incremental rta_state_admit of one service against that core's cached
+// response times.  A service whose first job on a core runs past its next release has the rest of its busy period checked too,
+// so deadlines beyond the periods are placed only where every job meets them, and on one core a set is placed exactly when the
+// completion test accepts it in deadline monotonic order.
+//
+// partition_services partitions a whole set at once.  A partition can also be kept and changed one service at a time: after
+// partition_clear, partition_place admits a service to a core chosen by the heuristic and partition_withdraw takes it off again,
+// each touching only that core's analysis (admission.h builds an online admission controller on these).
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "feasibility.h"
+#include "rta.h"
+
+#define PARTITION_FF 0
+#define PARTITION_BF 1
+#define PARTITION_WF 2
+
+// Core of a service that could not be placed on any core
+#define PARTITION_UNASSIGNED (~0U)
+
+extern const char *partition_heuristic_names[];
+
+// A partition of one task set; the buffers are reused (and grown as needed) from one call to the next
+typedef struct
+{
+    U32_T numCores;
+    U32_T numServices;
+    U32_T numUnassigned;
+    U32_T *core;            // core of each service, or PARTITION_UNASSIGNED
+    double *utilization;    // utilization of each core
+    rta_state_t *cores;     // the services placed on each core, with their response times
+    U32_T coreCapacity;
+    U32_T serviceCapacity;
+    U32_T *sorted;          // services in decreasing utilization order
+    U32_T *coreOrder;       // cores in the order the heuristic tries them
+} partition_t;
+
+void partition_init(partition_t *part);
+void partition_free(partition_t *part);
+int partition_services(partition_t *part, U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                       U32_T numCores, int heuristic);
+int partition_clear(partition_t *part, U32_T numCores);
+U32_T partition_place(partition_t *part, U32_T period, U32_T wcet, U32_T deadline, int heuristic);
+int partition_withdraw(partition_t *part, U32_T core, U32_T period, U32_T wcet, U32_T deadline, int heuristic);
+U64_T partition_response_time(const partition_t *part, U32_T core, U32_T period, U32_T wcet, U32_T deadline);
+U32_T partition_min_cores(partition_t *part, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                          const U32_T deadline[], int heuristic);
+
+#endif
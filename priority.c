@@ -0,0 +1,123 @@
+// Automatic priority ordering - see priority.h
+
+#include "priority.h"
+#include "rta.h"
+
+const char *priority_policy_names[] = {"rm", "dm", "opa"};
+
+// TRUE when service a sorts before service b: by the primary key, then the secondary key, then the index
+static inline int priority_before(const U32_T primary[], const U32_T secondary[], U32_T a, U32_T b)
+{
+    if(primary[a] != primary[b])
+        return primary[a] < primary[b];
+    if(secondary[a] != secondary[b])
+        return secondary[a] < secondary[b];
+    return a < b;
+}
+
+static void priority_sift_down(U32_T order[], U32_T pos, U32_T count, const U32_T primary[], const U32_T secondary[])
+{
+    U32_T child, tmp;
+
+    while((child = 2*pos + 1) < count)
+    {
+        if(child+1 < count && priority_before(primary, secondary, order[child], order[child+1]))
+            child++;
+        if(!priority_before(primary, secondary, order[pos], order[child]))
+            break;
+        tmp = order[pos]; order[pos] = order[child]; order[child] = tmp;
+        pos = child;
+    }
+}
+
+// Heapsort of the service indexes, which needs no scratch memory and is O(n log n) even for adversarial key patterns
+static void priority_sort(U32_T numServices, U32_T order[], const U32_T primary[], const U32_T secondary[])
+{
+    U32_T i, tmp;
+
+    for(i=0; i < numServices; i++)
+        order[i] = i;
+    if(numServices < 2)
+        return;
+
+    for(i=numServices/2; i-- > 0;)
+        priority_sift_down(order, i, numServices, primary, secondary);
+
+    for(i=numServices-1; i > 0; i--)
+    {
+        tmp = order[0]; order[0] = order[i]; order[i] = tmp;
+        priority_sift_down(order, 0, i, primary, secondary);
+    }
+}
+
+/* Audsley's algorithm, filling the priority levels from the lowest.  The response time of the service at a level depends only on
+ * the set of services above it, not their order, so a level can be given to any unassigned service that meets its deadline with
+ * all the other unassigned services at higher priority.  Starting from the DM order and trying the candidates from the longest
+ * deadline down means the DM order is kept wherever it already works.  Returns FALSE when some level has no candidate, in which
+ * case no fixed priority order is feasible.  Each candidate is checked over its whole busy period, which depends on the same
+ * set of services above it, so the order found holds for deadlines beyond the periods too.
+ */
+static int priority_opa(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], U32_T order[])
+{
+    U32_T level, pos, tmp;
+    U64_T r;
+
+    for(level=numServices; level-- > 0;)
+    {
+        for(pos=level+1; pos-- > 0;)
+        {
+            tmp = order[pos]; order[pos] = order[level]; order[level] = tmp;
+            if(rta_response_time_busy_period(level, order, period, wcet, deadline[order[level]], RTA_STOP_ON_MISS, &r) &&
+               r <= deadline[order[level]])
+                break;
+            tmp = order[pos]; order[pos] = order[level]; order[level] = tmp;
+        }
+        if(pos == ~0U)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Fill order[] with the service indexes highest priority first for policy.  Returns TRUE, or for PRIORITY_OPA FALSE when no
+ * feasible order exists (order[] is then a valid permutation, but not a feasible one).
+ */
+int priority_order(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy,
+                   U32_T order[])
+{
+    if(policy == PRIORITY_RM)
+    {
+        priority_sort(numServices, order, period, deadline);
+        return TRUE;
+    }
+
+    priority_sort(numServices, order, deadline, period);
+    if(policy == PRIORITY_OPA)
+        return priority_opa(numServices, period, wcet, deadline, order);
+
+    return TRUE;
+}
+
+/* Rearrange the arrays into the given order, in place, so that service i afterwards is the one that was order[i].  Each cycle of
+ * the permutation is rotated in turn; order[] is consumed (left as the identity).
+ */
+void priority_permute(U32_T numServices, U32_T order[], U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    U32_T i, j, k, t, c, d;
+
+    for(i=0; i < numServices; i++)
+    {
+        if(order[i] == i)
+            continue;
+
+        t = period[i]; c = wcet[i]; d = deadline[i];
+        for(j=i; order[j] != i; j=k)
+        {
+            k = order[j];
+            period[j] = period[k]; wcet[j] = wcet[k]; deadline[j] = deadline[k];
+            order[j] = j;
+        }
+        period[j] = t; wcet[j] = c; deadline[j] = d;
+        order[j] = j;
+    }
+}
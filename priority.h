@@ -0,0 +1,29 @@
+// Automatic priority ordering for the fixed priority tests
+//
+// The fixed priority tests take the services highest priority first, in array order.  Rather than relying on the caller to
+// pre-sort the arrays, priority_order builds the order as a permutation of the service indexes:
+//
+//     PRIORITY_RM   shortest period first (ties by deadline)
+//     PRIORITY_DM   shortest deadline first (ties by period), optimal for D <= T
+//     PRIORITY_OPA  Audsley's optimal priority assignment, which finds a feasible order whenever one exists even where DM is not
+//                   optimal, using the response time test as the oracle for each priority level
+//
+// Ties that remain are broken by the lower service index, so the orders are deterministic.  The permutation can be passed to the
+// ordered analyses (rta.h) directly, or applied to the arrays with priority_permute.
+
+#ifndef PRIORITY_H
+#define PRIORITY_H
+
+#include "feasibility.h"
+
+#define PRIORITY_RM 0
+#define PRIORITY_DM 1
+#define PRIORITY_OPA 2
+
+extern const char *priority_policy_names[];
+
+int priority_order(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy,
+                   U32_T order[]);
+void priority_permute(U32_T numServices, U32_T order[], U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+#endif
@@ -0,0 +1,772 @@
+// Integer response time analysis (completion test) engine - see rta.h
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rta.h"
+#include "simd.h"
+
+// Per-thread cache of the number of releases of each higher priority service counted in the current estimate
+static __thread U64_T *rta_releases = NULL;
+static __thread U32_T rta_releases_capacity = 0;
+
+// The service at priority level k, for an optional permutation of the service indexes
+#define SERVICE(order, k) ((order) ? (order)[k] : (k))
+
+// Iterations after which a fixed point that has not converged is checked for a saturated higher priority set
+#define RTA_SATURATION_CHECK 64
+
+// Most jobs of one service examined in its level-i busy period when its deadline exceeds its period
+#define RTA_BUSY_PERIOD_JOBS 65536
+
+// exact ceil(a/b) for b > 0, without the a+b-1 overflow
+static inline U64_T ceil_div(U64_T a, U64_T b)
+{
+    return a / b + (a % b != 0);
+}
+
+static U64_T *rta_release_cache(U32_T count)
+{
+    U64_T *p;
+
+    if(count > rta_releases_capacity)
+    {
+        if((p = realloc(rta_releases, count * sizeof(U64_T))) == NULL)
+            return NULL;
+        rta_releases = p;
+        rta_releases_capacity = count;
+    }
+
+    return rta_releases;
+}
+
+static U64_T gcd(U64_T a, U64_T b)
+{
+    U64_T t;
+
+    while(b)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/* Compare the utilization of the services at priority levels 0..numServices-1 of order (services 0..numServices-1 when order
+ * is NULL), each with overhead added to its WCET, with 1, returning a value less than, equal to or greater than 0.  The sum of
+ * C(j)/T(j) is kept as an exact fraction while the common denominator fits in 64 bits, and in long double precision after that
+ * (where a sum within 1e-15 of 1 counts as equal).
+ */
+static int utilization_compare_order(U32_T numServices, const U32_T order[], const U32_T period[], const U32_T wcet[],
+                                     U64_T overhead)
+{
+    unsigned __int128 num = 0, den = 1, newDen;
+    long double utility_sum;
+    U32_T j, k;
+
+    for(j=0; j < numServices; j++)
+    {
+        k = SERVICE(order, j);
+        newDen = den / gcd((U64_T)den, period[k]) * period[k];
+        if(newDen > ~0ULL)
+            break;
+
+        num = num * (newDen / den) + ((unsigned __int128)wcet[k] + overhead) * (newDen / period[k]);
+        den = newDen;
+        if(num > den)
+            return 1;
+    }
+    if(j == numServices)
+        return (num == den) ? 0 : -1;
+
+    utility_sum = 0.0L;
+    for(j=0; j < numServices; j++)
+    {
+        k = SERVICE(order, j);
+        utility_sum += ((long double)wcet[k] + overhead) / (long double)period[k];
+    }
+
+    if(utility_sum > 1.0L + 1e-15L)
+        return 1;
+    return (utility_sum >= 1.0L - 1e-15L) ? 0 : -1;
+}
+
+int utilization_compare(U32_T numServices, const U32_T period[], const U32_T wcet[])
+{
+    return utilization_compare_order(numServices, NULL, period, wcet, 0);
+}
+
+/* Demand of the service at priority level i in a window of length an: base, its own cost, plus the interference of the
+ * services at levels 0..i-1, each job costing its WCET plus overhead and with releases counted over the window extended by the
+ * service's jitter (when jitter is not NULL).  Also records the number of releases of each higher priority service when releases
+ * is not NULL.  Returns FALSE if the sum overflows.
+ */
+static inline int rta_demand(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], const U32_T jitter[],
+                             U64_T overhead, U64_T base, U64_T an, U64_T releases[], U64_T *demand)
+{
+    U64_T sum = base, q, term, window;
+    U32_T j, k;
+
+    FEASIBILITY_COUNT(iterations, 1);
+    FEASIBILITY_COUNT(divisions, i);
+    for(j=0; j < i; j++)
+    {
+        k = SERVICE(order, j);
+        if(__builtin_add_overflow(an, (U64_T)(jitter ? jitter[k] : 0), &window))
+            return FALSE;
+        q = ceil_div(window, period[k]);
+        if(releases)
+            releases[j] = q;
+        if(__builtin_mul_overflow(q, wcet[k] + overhead, &term) || __builtin_add_overflow(sum, term, &sum))
+            return FALSE;
+    }
+
+    *demand = sum;
+    return TRUE;
+}
+
+/* The fixed point of rta_response_time_ordered for services in array order, with the interference summed in full by the vector
+ * kernels at every step in place of the release cache.  Returns TRUE or FALSE as rta_response_time_ordered, or -1 with the
+ * estimate reached so far in *response once the sums leave the exact range of the kernels.
+ */
+static int rta_response_time_simd(U32_T i, const U32_T period[], const U32_T wcet[], U64_T base, U64_T an, U64_T limit,
+                                  U64_T *response)
+{
+    U64_T anext;
+    U32_T iterations = 0;
+
+    for(;;)
+    {
+        FEASIBILITY_COUNT(iterations, 1);
+        FEASIBILITY_COUNT(divisions, i);
+        if(!simd_demand_u32(period, wcet, i, an, base, RTA_RESPONSE_UNKNOWN, &anext))
+        {
+            *response = an;
+            return -1;
+        }
+        if(anext == an)
+            break;
+
+        an = anext;
+        if(an > limit)
+        {
+            *response = an;
+            return FALSE;
+        }
+        if(++iterations == RTA_SATURATION_CHECK && utilization_compare_order(i, NULL, period, wcet, 0) >= (base == 0))
+        {
+            *response = RTA_RESPONSE_UNKNOWN;
+            return FALSE;
+        }
+    }
+
+    *response = an;
+    return TRUE;
+}
+
+/* The completion test fixed point shared by the plain and the overhead analyses: the smallest w >= seed with w = demand(w) as
+ * rta_demand gives it, starting from base plus one job of each higher priority service when seed is 0.  The plain analyses pass
+ * no jitter and no overhead; the function is always inlined so that those fold away.
+ */
+static inline __attribute__((always_inline)) int rta_fixed_point(U32_T i, const U32_T order[], const U32_T period[],
+                                                                 const U32_T wcet[], const U32_T jitter[], U64_T overhead,
+                                                                 U64_T base, U64_T seed, U64_T limit, U64_T *response)
+{
+    U64_T an = seed, anext, *releases, q, term, end, window;
+    U32_T j, k, iterations = 0;
+    int converged;
+
+    if(an == 0)
+    {
+        an = base;
+        for(j=0; j < i; j++)
+            an += wcet[SERVICE(order, j)] + overhead;
+    }
+
+    if(an > limit)
+    {
+        *response = an;
+        return FALSE;
+    }
+
+    // long higher priority sets in array order go to the vector kernels, which hand back the estimate if they cannot finish
+    if(order == NULL && jitter == NULL && overhead == 0 && i >= SIMD_MIN_SERVICES && simd_level != SIMD_SCALAR)
+    {
+        if((converged = rta_response_time_simd(i, period, wcet, base, an, limit, response)) >= 0)
+            return converged;
+        an = *response;
+    }
+
+    releases = rta_release_cache(i);
+    if(!rta_demand(i, order, period, wcet, jitter, overhead, base, an, releases, &anext))
+    {
+        *response = RTA_RESPONSE_UNKNOWN;
+        return FALSE;
+    }
+
+    while(anext != an)
+    {
+        an = anext;
+        if(an > limit)
+        {
+            *response = an;
+            return FALSE;
+        }
+        // with the higher priority services using 100% or more there is no fixed point, and at exactly 100% the estimate
+        // would only grow by C(i) per hyperperiod; with no base cost (a busy period) 100% still ends at the hyperperiod
+        if(++iterations == RTA_SATURATION_CHECK && utilization_compare_order(i, order, period, wcet, overhead) >= (base == 0))
+        {
+            *response = RTA_RESPONSE_UNKNOWN;
+            return FALSE;
+        }
+
+        if(releases == NULL)
+        {
+            if(!rta_demand(i, order, period, wcet, jitter, overhead, base, an, NULL, &anext))
+            {
+                *response = RTA_RESPONSE_UNKNOWN;
+                return FALSE;
+            }
+            continue;
+        }
+
+        // only services whose counted releases no longer cover the window add interference
+        FEASIBILITY_COUNT(iterations, 1);
+        for(j=0; j < i; j++)
+        {
+            k = SERVICE(order, j);
+            if(__builtin_add_overflow(an, (U64_T)(jitter ? jitter[k] : 0), &window))
+            {
+                *response = RTA_RESPONSE_UNKNOWN;
+                return FALSE;
+            }
+            if(__builtin_mul_overflow(releases[j], (U64_T)period[k], &end) || window <= end)
+                continue;
+
+            FEASIBILITY_COUNT(divisions, 1);
+            q = ceil_div(window, period[k]);
+            if(__builtin_mul_overflow(q - releases[j], wcet[k] + overhead, &term) ||
+               __builtin_add_overflow(anext, term, &anext))
+            {
+                *response = RTA_RESPONSE_UNKNOWN;
+                return FALSE;
+            }
+            releases[j] = q;
+        }
+    }
+
+    *response = an;
+    return TRUE;
+}
+
+/* Iterate the completion test fixed point for the service at priority level i of order (service i when order is NULL), with the
+ * services at levels 0..i-1 as the higher priority set, returning TRUE with the response time in *response.  The iteration
+ * starts from seed, which must not exceed the response time (pass 0 for the sum of the WCETs, the starting point of the original
+ * test).  The estimate only ever increases, so the interference of a higher priority service is only recomputed once the
+ * estimate passes the end of the releases already counted for it.
+ *
+ * Since the estimate never decreases, the iteration is abandoned as soon as it exceeds limit (pass the deadline to stop on a
+ * miss, or RTA_RESPONSE_UNKNOWN for the exact value regardless); FALSE is then returned with the estimate that crossed the
+ * limit, a lower bound on the response time.  FALSE with RTA_RESPONSE_UNKNOWN means the response time is unbounded: either the
+ * estimate overflowed 64 bits or a slow iteration was found to have a higher priority load of 100% or more.
+ */
+int rta_response_time_ordered(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T seed, U64_T limit,
+                              U64_T *response)
+{
+    return rta_fixed_point(i, order, period, wcet, NULL, 0, wcet[SERVICE(order, i)], seed, limit, response);
+}
+
+/* As rta_response_time_ordered, but for the smallest w = base + sum over levels j < i of ceil(w/T(j)) * C(j), where base stands
+ * in for the WCET of the service at level i and may carry a fixed interference too.  order[] need not hold every service, so a
+ * fixed point over a subset of the higher priority services (those at its first i levels) can be taken.
+ */
+int rta_response_time_base(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T base, U64_T seed,
+                           U64_T limit, U64_T *response)
+{
+    return rta_fixed_point(i, order, period, wcet, NULL, 0, base, seed, limit, response);
+}
+
+int rta_response_time(U32_T i, const U32_T period[], const U32_T wcet[], U64_T seed, U64_T limit, U64_T *response)
+{
+    return rta_response_time_ordered(i, NULL, period, wcet, seed, limit, response);
+}
+
+/* Worst case response time of the service at priority level i of order when its first job, with response time first, completes
+ * after its second release, which a service can only do and still be feasible when D(i) > T(i).  The later jobs of the level-i
+ * busy period can then respond more slowly than the first.  Job q, released at q*T(i), completes at the smallest
+ *
+ *     w(q) = (q+1)*C(i) + sum over j < i of ceil(w(q)/T(j)) * C(j)
+ *
+ * and R(i) is the largest w(q) - q*T(i) over the ceil(L/T(i)) jobs released in the busy period, whose length L is the smallest
+ * L = sum over j <= i of ceil(L/T(j)) * C(j).  L is found once, from the first job's completion (a lower bound on it); each w(q)
+ * is seeded from w(q-1) + C(i).  A busy period of more than RTA_BUSY_PERIOD_JOBS jobs is not examined and the response time is
+ * reported unbounded, which keeps the cost bounded at the price of rejecting such sets.
+ *
+ * The overhead analysis passes its jitter, per-job overhead and blocking (Tindell, Burns and Wellings): each job also pays B(i)
+ * and the overhead, the releases of every service, the one analyzed included, are counted over the window extended by its
+ * jitter, so L = B(i) + sum over j <= i of ceil((L + J(j))/T(j)) * C'(j) holds ceil((L + J(i))/T(i)) jobs, and first and the
+ * result are windows w, without J(i).  The plain analyses pass no jitter, overhead or blocking.
+ *
+ * Each job's iteration is abandoned once it passes deadline + q*T(i) when stop is set.  Returns TRUE or FALSE with *response as
+ * rta_response_time_ordered.
+ */
+static int rta_busy_period(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], const U32_T jitter[],
+                           U64_T overhead, U64_T blocking, U64_T deadline, U64_T first, int stop, U64_T *response)
+{
+    U64_T T = period[SERVICE(order, i)], C = wcet[SERVICE(order, i)] + overhead, length, jobs, q, w = first, base, limit, r;
+    U64_T J = jitter ? jitter[SERVICE(order, i)] : 0;
+
+    // the busy period, given up once it spans more jobs than are examined
+    if(!rta_fixed_point(i+1, order, period, wcet, jitter, overhead, blocking, first, RTA_BUSY_PERIOD_JOBS * T, &length))
+    {
+        *response = RTA_RESPONSE_UNKNOWN;
+        return FALSE;
+    }
+
+    *response = first;
+    jobs = ceil_div(length + J, T);
+    for(q=1; q < jobs; q++)
+    {
+        base = blocking + (q+1) * C;
+        limit = stop ? deadline + q*T : RTA_RESPONSE_UNKNOWN;
+        if(!rta_fixed_point(i, order, period, wcet, jitter, overhead, base, w + C, limit, &w))
+        {
+            *response = (w == RTA_RESPONSE_UNKNOWN) ? w : w - q*T;
+            return FALSE;
+        }
+
+        r = w - q*T;
+        if(r > *response)
+            *response = r;
+    }
+
+    return TRUE;
+}
+
+/* Worst case response time of the service at priority level i of order over every job of its level-i busy period, so that it
+ * holds whatever the deadline, from the fixed point of the first job onward.  With RTA_STOP_ON_MISS each job stops at its
+ * deadline.  Returns TRUE or FALSE with *response as rta_response_time_ordered.
+ */
+int rta_response_time_busy_period(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T deadline,
+                                  int flags, U64_T *response)
+{
+    U64_T limit = (flags & RTA_STOP_ON_MISS) ? deadline : RTA_RESPONSE_UNKNOWN, first;
+
+    if(!rta_response_time_ordered(i, order, period, wcet, 0, limit, &first))
+    {
+        *response = first;
+        return FALSE;
+    }
+    if(first <= period[SERVICE(order, i)])
+    {
+        *response = first;
+        return TRUE;
+    }
+
+    return rta_busy_period(i, order, period, wcet, NULL, 0, 0, deadline, first, flags & RTA_STOP_ON_MISS, response);
+}
+
+/* Worst case response time of every service with priorities given by order (highest first, or the array order when order is
+ * NULL), returning TRUE when all of them meet their deadlines.  response[] is indexed by service, not priority level, and may be
+ * NULL when only the decision is needed.  With RTA_STOP_ON_MISS the analysis ends at the first service to miss: its entry holds
+ * the lower bound that crossed the deadline and the entries of the lower priority services are RTA_RESPONSE_UNKNOWN.
+ *
+ * R(i-1) + C(i) is a lower bound on R(i), so each service is seeded from the converged response time of the one before it.  If
+ * R(i-1) is unbounded then so is R(i).  Deadlines may exceed periods: a first job that completes after the service's next
+ * release leaves the rest of its busy period to rta_busy_period, and the seed stays the first job's response time.  A busy
+ * period too long to examine leaves only that service's response time unknown, since its first job still seeds the next.
+ */
+int rta_response_times_ordered(U32_T numServices, const U32_T order[], const U32_T period[], const U32_T wcet[],
+                               const U32_T deadline[], U64_T response[], int flags)
+{
+    U64_T limit, r, first, seed = 0;
+    int set_feasible = TRUE, converged, bounded;
+    U32_T i, k;
+
+    for(i=0; i < numServices; i++)
+    {
+        k = SERVICE(order, i);
+        limit = (flags & RTA_STOP_ON_MISS) ? deadline[k] : RTA_RESPONSE_UNKNOWN;
+
+        if(i > 0 && seed == 0)
+        {
+            r = RTA_RESPONSE_UNKNOWN;
+            converged = FALSE;
+        }
+        else
+            converged = rta_response_time_ordered(i, order, period, wcet, seed, limit, &r);
+        first = r;
+        bounded = converged;
+
+        if(converged && r > period[k] && r <= deadline[k])
+            converged = rta_busy_period(i, order, period, wcet, NULL, 0, 0, deadline[k], first, flags & RTA_STOP_ON_MISS, &r);
+
+        if(!converged || r > deadline[k])
+            set_feasible = FALSE;
+
+        if(response)
+            response[k] = r;
+
+        if(!set_feasible && (flags & RTA_STOP_ON_MISS))
+        {
+            if(response)
+                for(i++; i < numServices; i++)
+                    response[SERVICE(order, i)] = RTA_RESPONSE_UNKNOWN;
+            break;
+        }
+
+        // an unbounded first job or an overflowing seed means the next response time is unbounded too
+        if(!bounded || i+1 == numServices || __builtin_add_overflow(first, (U64_T)wcet[SERVICE(order, i+1)], &seed))
+            seed = 0;
+    }
+
+    return set_feasible;
+}
+
+int rta_response_times(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                       U64_T response[], int flags)
+{
+    return rta_response_times_ordered(numServices, NULL, period, wcet, deadline, response, flags);
+}
+
+int rta_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return rta_response_times(numServices, period, wcet, deadline, NULL, RTA_STOP_ON_MISS);
+}
+
+/* Completion test with the priority order given as a permutation of the service indexes (see priority.h) rather than by the order
+ * of the arrays themselves.
+ */
+int completion_time_feasibility_ordered(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[], const U32_T order[])
+{
+    return rta_response_times_ordered(numServices, order, period, wcet, deadline, NULL, RTA_STOP_ON_MISS);
+}
+
+/* Worst case response times R(i) = J(i) + w(i) of every service in array priority order, with the jitter, blocking and context
+ * switch cost of overheads (see rta.h), otherwise as rta_response_times: TRUE when every service meets its deadline, response
+ * may be NULL, and RTA_STOP_ON_MISS ends the analysis at the first miss with a lower bound in its entry.  A first job that
+ * completes after the next release of its service, R(i) > T(i), leaves the later jobs of its busy period to rta_busy_period, so
+ * with no overheads this is the same analysis as rta_response_times whatever the deadlines.
+ *
+ * w(i-1) - B(i-1) + B(i) + C'(i) is a lower bound on the first job's w(i) when B(i) + C'(i) >= B(i-1), which reduces to the seed
+ * of rta_response_times without blocking; otherwise w(i) starts from its own cost and one job of each higher priority service.
+ */
+int rta_response_times_overheads(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                                 const rta_overheads_t *overheads, U64_T response[], int flags)
+{
+    U64_T overhead = 2 * (U64_T)overheads->contextSwitch, base, limit, w, seed = 0, prevW = 0, prevBlocking = 0;
+    U64_T jitter, blocking, r;
+    int set_feasible = TRUE, converged, bounded = TRUE;
+    U32_T i;
+
+    for(i=0; i < numServices; i++)
+    {
+        jitter = overheads->jitter ? overheads->jitter[i] : 0;
+        blocking = overheads->blocking ? overheads->blocking[i] : 0;
+        base = blocking + wcet[i] + overhead;
+
+        // the busy window has to end by D(i) - J(i)
+        if(flags & RTA_STOP_ON_MISS)
+            limit = (deadline[i] > jitter) ? deadline[i] - jitter : 0;
+        else
+            limit = RTA_RESPONSE_UNKNOWN;
+
+        // only an unbounded first job above makes this one unbounded; a busy period above too long to examine does not
+        if(i > 0 && !bounded)
+        {
+            converged = FALSE;
+            w = RTA_RESPONSE_UNKNOWN;
+        }
+        else
+        {
+            if(i == 0 || base < prevBlocking || __builtin_add_overflow(prevW, base - prevBlocking, &seed))
+                seed = 0;
+            converged = rta_fixed_point(i, NULL, period, wcet, overheads->jitter, overhead, base, seed, limit, &w);
+        }
+        bounded = converged;
+
+        if(w == RTA_RESPONSE_UNKNOWN || __builtin_add_overflow(w, jitter, &r))
+            r = RTA_RESPONSE_UNKNOWN;
+        else if(converged && r > period[i] && r <= deadline[i])
+        {
+            // the busy period's worst window, of which the first job's w stays the seed of the next service
+            converged = rta_busy_period(i, NULL, period, wcet, overheads->jitter, overhead, blocking, limit, w,
+                                        flags & RTA_STOP_ON_MISS, &r);
+            if(r == RTA_RESPONSE_UNKNOWN || __builtin_add_overflow(r, jitter, &r))
+                r = RTA_RESPONSE_UNKNOWN;
+        }
+        if(!converged || r > deadline[i])
+            set_feasible = FALSE;
+        if(response)
+            response[i] = r;
+
+        if(!set_feasible && (flags & RTA_STOP_ON_MISS))
+        {
+            if(response)
+                for(i++; i < numServices; i++)
+                    response[i] = RTA_RESPONSE_UNKNOWN;
+            break;
+        }
+
+        prevW = w;
+        prevBlocking = blocking;
+    }
+
+    return set_feasible;
+}
+
+/* Blocking terms under the priority ceiling protocol (or the stack resource policy) for services in array priority order: a
+ * service can be blocked by at most one critical section of a lower priority service, on a resource whose ceiling (the priority
+ * of its highest priority user) is at or above its own.  csLength[j*numResources + r] is the longest critical section of
+ * service j on resource r, 0 where j does not use r.  Returns TRUE with B(i) in blocking[], or -1 if memory ran out.
+ */
+int rta_pcp_blocking(U32_T numServices, U32_T numResources, const U32_T csLength[], U32_T blocking[])
+{
+    U32_T *ceiling, *lowerMax, i, r, b;
+
+    if((ceiling = malloc(2 * (numResources ? numResources : 1) * sizeof(U32_T))) == NULL)
+        return -1;
+    lowerMax = ceiling + numResources;
+
+    for(r=0; r < numResources; r++)
+    {
+        ceiling[r] = numServices;
+        lowerMax[r] = 0;
+        for(i=0; i < numServices; i++)
+            if(csLength[(size_t)i * numResources + r])
+            {
+                ceiling[r] = i;
+                break;
+            }
+    }
+
+    // from the lowest priority up, lowerMax[r] is the longest section on r of the services below level i
+    for(i=numServices; i-- > 0; )
+    {
+        b = 0;
+        for(r=0; r < numResources; r++)
+            if(ceiling[r] <= i && lowerMax[r] > b)
+                b = lowerMax[r];
+        blocking[i] = b;
+
+        for(r=0; r < numResources; r++)
+            if(csLength[(size_t)i * numResources + r] > lowerMax[r])
+                lowerMax[r] = csLength[(size_t)i * numResources + r];
+    }
+
+    free(ceiling);
+    return TRUE;
+}
+
+void rta_state_init(rta_state_t *state)
+{
+    memset(state, 0, sizeof(*state));
+}
+
+void rta_state_free(rta_state_t *state)
+{
+    free(state->period);
+    free(state->wcet);
+    free(state->deadline);
+    free(state->response);
+    free(state->scratch);
+    rta_state_init(state);
+}
+
+// Empty the set, keeping its buffers for reuse
+void rta_state_clear(rta_state_t *state)
+{
+    state->numServices = 0;
+    state->numMisses = 0;
+}
+
+static int rta_state_reserve(rta_state_t *state, U32_T needed)
+{
+    U32_T newCapacity;
+    U32_T *p;
+    U64_T *r;
+
+    if(needed <= state->capacity)
+        return TRUE;
+
+    newCapacity = state->capacity ? state->capacity : 16;
+    while(newCapacity < needed)
+        newCapacity *= 2;
+
+    if((p = realloc(state->period, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    state->period = p;
+    if((p = realloc(state->wcet, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    state->wcet = p;
+    if((p = realloc(state->deadline, newCapacity * sizeof(U32_T))) == NULL) return FALSE;
+    state->deadline = p;
+    if((r = realloc(state->response, newCapacity * sizeof(U64_T))) == NULL) return FALSE;
+    state->response = r;
+    if((r = realloc(state->scratch, newCapacity * sizeof(U64_T))) == NULL) return FALSE;
+    state->scratch = r;
+
+    state->capacity = newCapacity;
+    return TRUE;
+}
+
+// Deadline monotonic position for a new service: after every service with a shorter deadline, or an equal deadline and period
+static U32_T rta_state_position(const rta_state_t *state, U32_T period, U32_T deadline)
+{
+    U32_T pos;
+
+    for(pos=0; pos < state->numServices; pos++)
+        if(state->deadline[pos] > deadline || (state->deadline[pos] == deadline && state->period[pos] > period))
+            break;
+
+    return pos;
+}
+
+static void rta_state_insert(rta_state_t *state, U32_T pos, U32_T period, U32_T wcet, U32_T deadline)
+{
+    U32_T count = state->numServices - pos;
+
+    memmove(&state->period[pos+1], &state->period[pos], count * sizeof(U32_T));
+    memmove(&state->wcet[pos+1], &state->wcet[pos], count * sizeof(U32_T));
+    memmove(&state->deadline[pos+1], &state->deadline[pos], count * sizeof(U32_T));
+    memmove(&state->response[pos+1], &state->response[pos], count * sizeof(U64_T));
+
+    state->period[pos] = period;
+    state->wcet[pos] = wcet;
+    state->deadline[pos] = deadline;
+    state->response[pos] = 0;
+    state->numServices++;
+}
+
+static void rta_state_delete(rta_state_t *state, U32_T pos)
+{
+    U32_T count = state->numServices - pos - 1;
+
+    memmove(&state->period[pos], &state->period[pos+1], count * sizeof(U32_T));
+    memmove(&state->wcet[pos], &state->wcet[pos+1], count * sizeof(U32_T));
+    memmove(&state->deadline[pos], &state->deadline[pos+1], count * sizeof(U32_T));
+    memmove(&state->response[pos], &state->response[pos+1], count * sizeof(U64_T));
+    state->numServices--;
+}
+
+/* Recompute the response times of services from..numServices-1 into out[] (which may alias state->response + from) and return
+ * the number of misses among them.  Each service is seeded from R(i-1) + C(i).  When grown is set load has only been added, so a
+ * service's previous response time (still in state->response) is also a lower bound, and one that was unbounded stays unbounded.
+ * With limit set, the deadline bounds each iteration and the update stops at the first miss.
+ *
+ * A first job that completes after the service's next release leaves the rest of its busy period to rta_busy_period, as in
+ * rta_response_times_ordered.  The cached response time is then that of a later job, which is no lower bound on the first job
+ * of the service below or of the same service in a changed set, so only a cached time within the period serves as a seed.  An
+ * unknown R(i-1) may only be a busy period too long to examine, so the service below is still analyzed, from no seed; the
+ * saturation check ends that analysis quickly when it is unbounded too.
+ */
+static U32_T rta_state_update(rta_state_t *state, U32_T from, U64_T out[], int grown, int limit)
+{
+    U64_T prev, seed, old, r;
+    U32_T i, misses = 0;
+    int converged;
+
+    for(i=from; i < state->numServices; i++)
+    {
+        prev = (i == 0) ? 0 : (i == from) ? state->response[i-1] : out[i-from-1];
+        old = state->response[i];
+
+        if(grown && i > from && old == RTA_RESPONSE_UNKNOWN)
+            r = RTA_RESPONSE_UNKNOWN;
+        else
+        {
+            seed = (i == 0 || prev > state->period[i-1]) ? 0 : prev + state->wcet[i];
+            if(grown && i > from && old > seed && old <= state->period[i])
+                seed = old;
+
+            converged = rta_response_time(i, state->period, state->wcet, seed,
+                                          limit ? state->deadline[i] : RTA_RESPONSE_UNKNOWN, &r);
+            if(converged && r > state->period[i] && r <= state->deadline[i])
+                converged = rta_busy_period(i, NULL, state->period, state->wcet, NULL, 0, 0, state->deadline[i], r, limit, &r);
+            if(!converged && limit)
+                r = RTA_RESPONSE_UNKNOWN;
+        }
+
+        out[i-from] = r;
+        if(r == RTA_RESPONSE_UNKNOWN || r > state->deadline[i])
+        {
+            misses++;
+            if(limit)
+                break;
+        }
+    }
+
+    return misses;
+}
+
+static U32_T rta_state_count_misses(const rta_state_t *state)
+{
+    U32_T i, misses = 0;
+
+    for(i=0; i < state->numServices; i++)
+        if(state->response[i] == RTA_RESPONSE_UNKNOWN || state->response[i] > state->deadline[i])
+            misses++;
+
+    return misses;
+}
+
+/* Add a service in deadline monotonic order and update the response times of it and every lower priority service.  The services
+ * above it are unaffected and keep their cached results.  Returns TRUE when the whole set is feasible afterwards, FALSE when it
+ * is not or memory ran out (the set is then unchanged).  The position the service was inserted at is stored in *position when
+ * it is not NULL.
+ */
+int rta_state_add(rta_state_t *state, U32_T period, U32_T wcet, U32_T deadline, U32_T *position)
+{
+    U32_T pos;
+
+    if(!rta_state_reserve(state, state->numServices + 1))
+        return FALSE;
+
+    pos = rta_state_position(state, period, deadline);
+    rta_state_insert(state, pos, period, wcet, deadline);
+    rta_state_update(state, pos, &state->response[pos], TRUE, FALSE);
+    state->numMisses = rta_state_count_misses(state);
+
+    if(position)
+        *position = pos;
+    return (state->numMisses == 0);
+}
+
+/* Admission test: add the service only if the resulting set is feasible.  The trial analysis is bounded by each deadline and a
+ * rejected service leaves the set and its cached response times exactly as they were.
+ */
+int rta_state_admit(rta_state_t *state, U32_T period, U32_T wcet, U32_T deadline, U32_T *position)
+{
+    U32_T pos;
+
+    if(state->numMisses || !rta_state_reserve(state, state->numServices + 1))
+        return FALSE;
+
+    pos = rta_state_position(state, period, deadline);
+    rta_state_insert(state, pos, period, wcet, deadline);
+
+    if(rta_state_update(state, pos, state->scratch, TRUE, TRUE))
+    {
+        rta_state_delete(state, pos);
+        return FALSE;
+    }
+
+    memcpy(&state->response[pos], state->scratch, (state->numServices - pos) * sizeof(U64_T));
+    if(position)
+        *position = pos;
+    return TRUE;
+}
+
+/* Remove the service at position and update the services below it, which can only get faster, so they are seeded from the
+ * response time chain rather than their previous values.  Returns TRUE when the remaining set is feasible.
+ */
+int rta_state_remove(rta_state_t *state, U32_T position)
+{
+    if(position >= state->numServices)
+        return (state->numMisses == 0);
+
+    rta_state_delete(state, position);
+    rta_state_update(state, position, &state->response[position], FALSE, FALSE);
+    state->numMisses = rta_state_count_misses(state);
+
+    return (state->numMisses == 0);
+}
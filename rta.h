@@ -0,0 +1,94 @@
+// Integer response time analysis (completion test) engine
+//
+// Computes the same worst case response time fixed point as the original completion test,
+//
+//     R(i) = C(i) + sum over j < i of ceil(R(i)/T(j)) * C(j)
+//
+// but with exact integer ceiling division and 64-bit accumulation, so there is no rounding hazard for large periods and an
+// interference sum that would overflow is detected rather than wrapping.
+//
+// Deadlines may be longer than periods.  A job that completes after the next release of its service can delay that job, so the
+// later jobs of the level-i busy period are then analyzed too (Lehoczky; Tindell, Burns and Wellings):
+//
+//     L(i) = sum over j <= i of ceil(L(i)/T(j)) * C(j)
+//     w(q) = (q+1)*C(i) + sum over j < i of ceil(w(q)/T(j)) * C(j),    R(i) = max over q < ceil(L(i)/T(i)) of w(q) - q*T(i)
+//
+// The busy period length is found once per service and the jobs examined are capped, so the cost stays bounded.  rta_state_t
+// and the overhead analysis take the busy period the same way, the latter with its jitter, blocking and switch costs.
+//
+// The analysis is incremental: each service's iteration is seeded from the previous service's converged response time, and
+// rta_state_t keeps an analyzed set with its response times so single services can be admitted or removed without reanalyzing
+// the services above them.
+//
+// rta_response_times_overheads runs the same engine on the extended fixed point of Audsley, Burns, Richardson, Tindell and
+// Wellings, for threads that see release jitter, priority ceiling blocking and context switch costs:
+//
+//     w(i) = B(i) + C'(i) + sum over j < i of ceil((w(i) + J(j))/T(j)) * C'(j),    R(i) = J(i) + w(i)
+//
+// where C'(j) = C(j) + 2*Ccs charges each job for the switch to it and the switch away from it.
+
+#ifndef RTA_H
+#define RTA_H
+
+#include "feasibility.h"
+
+// Flags for rta_response_times()
+#define RTA_STOP_ON_MISS 0x1
+
+// Response time reported for a service that was not analyzed (after a stop on miss) or whose response time is unbounded
+#define RTA_RESPONSE_UNKNOWN (~0ULL)
+
+// Overheads for rta_response_times_overheads, in array priority order; a NULL array counts as all zeros
+typedef struct
+{
+    const U32_T *jitter;        // release jitter J(i), the latest a job can be released after its arrival
+    const U32_T *blocking;      // blocking B(i) by lower priority services, e.g. from rta_pcp_blocking
+    U32_T contextSwitch;        // cost of one context switch, charged twice per job (switching to it and away from it)
+} rta_overheads_t;
+
+// An analyzed task set kept in priority order (shortest deadline first, so RM when D=T) with its cached response times
+typedef struct
+{
+    U32_T numServices;
+    U32_T capacity;
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U64_T *response;
+    U64_T *scratch;     // trial response times while admitting a service
+    U32_T numMisses;    // services with response > deadline (or unbounded)
+} rta_state_t;
+
+int utilization_compare(U32_T numServices, const U32_T period[], const U32_T wcet[]);
+
+int rta_response_time(U32_T i, const U32_T period[], const U32_T wcet[], U64_T seed, U64_T limit, U64_T *response);
+int rta_response_times(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                       U64_T response[], int flags);
+int rta_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+// The same analyses with priorities given by order[], a permutation of the service indexes highest priority first
+int rta_response_time_ordered(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T seed, U64_T limit,
+                              U64_T *response);
+int rta_response_times_ordered(U32_T numServices, const U32_T order[], const U32_T period[], const U32_T wcet[],
+                               const U32_T deadline[], U64_T response[], int flags);
+int rta_response_time_base(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T base, U64_T seed,
+                           U64_T limit, U64_T *response);
+int completion_time_feasibility_ordered(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[], const U32_T order[]);
+
+// The response time of one service over its whole busy period, for deadlines longer than the period
+int rta_response_time_busy_period(U32_T i, const U32_T order[], const U32_T period[], const U32_T wcet[], U64_T deadline,
+                                  int flags, U64_T *response);
+
+// The completion test with release jitter, blocking and context switch overhead
+int rta_response_times_overheads(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                                 const rta_overheads_t *overheads, U64_T response[], int flags);
+int rta_pcp_blocking(U32_T numServices, U32_T numResources, const U32_T csLength[], U32_T blocking[]);
+
+void rta_state_init(rta_state_t *state);
+void rta_state_free(rta_state_t *state);
+void rta_state_clear(rta_state_t *state);
+int rta_state_add(rta_state_t *state, U32_T period, U32_T wcet, U32_T deadline, U32_T *position);
+int rta_state_admit(rta_state_t *state, U32_T period, U32_T wcet, U32_T deadline, U32_T *position);
+int rta_state_remove(rta_state_t *state, U32_T position);
+
+#endif
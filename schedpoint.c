@@ -0,0 +1,149 @@
+// Reduced scheduling point engine - see schedpoint.h
+
+#include <stdlib.h>
+
+#include "rta.h"
+#include "schedpoint.h"
+#include "simd.h"
+
+// Per-thread point set buffers, grown as needed and reused from one call to the next
+static __thread U64_T *sp_points = NULL, *sp_merged = NULL;
+static __thread size_t sp_capacity = 0;
+
+static int sp_reserve(size_t needed)
+{
+    U64_T *p;
+
+    if(needed <= sp_capacity)
+        return TRUE;
+
+    if((p = realloc(sp_points, needed * sizeof(U64_T))) == NULL) return FALSE;
+    sp_points = p;
+    if((p = realloc(sp_merged, needed * sizeof(U64_T))) == NULL) return FALSE;
+    sp_merged = p;
+
+    sp_capacity = needed;
+    return TRUE;
+}
+
+// C(i) + sum over j < i of ceil(t/T(j))*C(j), stopping early once it is known to exceed t
+static inline U64_T sp_demand(U32_T i, const U32_T period[], const U32_T wcet[], U64_T t)
+{
+    U64_T demand = wcet[i];
+    U32_T j;
+
+    FEASIBILITY_COUNT(points, 1);
+    if(i >= SIMD_MIN_SERVICES && simd_level != SIMD_SCALAR && simd_demand_u32(period, wcet, i, t, demand, t, &demand))
+    {
+        FEASIBILITY_COUNT(divisions, i);
+        return demand;
+    }
+
+    demand = wcet[i];
+    for(j=0; j < i && demand <= t; j++)
+        demand += (U64_T)wcet[j] * (t / period[j] + (t % period[j] != 0));
+    FEASIBILITY_COUNT(divisions, j);
+
+    return demand;
+}
+
+/* Build the points of P(i-1)(D(i)) that are >= lower in sp_points[], deduplicated and in decreasing order, and return how many
+ * there are (or -1 if memory ran out).  Applying floor(t/T(j))*T(j) keeps the points in decreasing order, so each step of the
+ * recursion is one merge of the current set with its image.  The image of a point is never larger than the point, so once a
+ * point falls below lower everything derived from it does too and it can be dropped.
+ */
+static long sp_build_points(U32_T i, const U32_T period[], const U32_T deadline[], U64_T lower)
+{
+    size_t count = 1, a, b, n;
+    U64_T *tmp, t, ta, tb;
+    U32_T j;
+
+    if(!sp_reserve(16))
+        return -1;
+    sp_points[0] = deadline[i];
+
+    for(j=i; j-- > 0; )
+    {
+        if(!sp_reserve(2 * count))
+            return -1;
+
+        // merge the set with its image under t -> floor(t/T(j))*T(j), both are decreasing
+        a = 0; b = 0; n = 0;
+        while(1)
+        {
+            ta = (a < count) ? sp_points[a] : 0;
+            tb = (b < count) ? sp_points[b] - sp_points[b] % period[j] : 0;
+            if(tb < lower)
+            {
+                tb = 0;
+                b = count;
+            }
+            if(ta == 0 && tb == 0)
+                break;
+
+            if(ta >= tb)
+            {
+                t = ta;
+                a++;
+            }
+            else
+            {
+                t = tb;
+                b++;
+            }
+
+            if(n == 0 || sp_merged[n-1] != t)
+                sp_merged[n++] = t;
+        }
+
+        tmp = sp_points; sp_points = sp_merged; sp_merged = tmp;
+        count = n;
+    }
+
+    return (long)count;
+}
+
+/* For each service the deadline, which is always in the set and the point most likely to satisfy the demand, is tried first.
+ * Otherwise the rest of the reduced set is built and checked from the largest point down.  No point below the service's
+ * response time can satisfy the demand, so the set is pruned below a cheap lower bound on it: the demand at the sum of the WCETs.
+ */
+int scheduling_point_feasibility_reduced(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    U64_T lower, response;
+    long count, p;
+    U32_T i, j;
+
+    for(i=0; i < numServices; i++)
+    {
+        // the points only cover the first job, which past the period can delay the jobs after it
+        if(deadline[i] > period[i])
+        {
+            if(!rta_response_time_busy_period(i, NULL, period, wcet, deadline[i], RTA_STOP_ON_MISS, &response) ||
+               response > deadline[i])
+                return FALSE;
+            continue;
+        }
+
+        if(sp_demand(i, period, wcet, deadline[i]) <= deadline[i])
+            continue;
+
+        for(lower=0, j=0; j <= i; j++)
+            lower += wcet[j];
+        if(lower > deadline[i])
+            return FALSE;
+        lower = sp_demand(i, period, wcet, lower);
+
+        if((count = sp_build_points(i, period, deadline, lower)) < 0)
+            return FALSE;
+
+        // can we get the CPU we need by any of the points?
+        for(p=1; p < count; p++)
+            if(sp_demand(i, period, wcet, sp_points[p]) <= sp_points[p])
+                break;
+
+        if(p >= count)
+            return FALSE;
+    }
+
+    return TRUE;
+}
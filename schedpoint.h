@@ -0,0 +1,17 @@
+// Reduced scheduling point engine
+//
+// The scheduling point test only needs to check the points of the Bini-Buttazzo set P(i-1)(D(i)), built by the recursion
+//
+//     P(0)(t) = { t },    P(j)(t) = P(j-1)(floor(t/T(j))*T(j)) U P(j-1)(t)
+//
+// rather than every multiple l*T(k) <= D(i) of every higher priority period.  Service i is feasible when, at some point t in the
+// set, C(i) + sum over j < i of ceil(t/T(j))*C(j) <= t.
+
+#ifndef SCHEDPOINT_H
+#define SCHEDPOINT_H
+
+#include "feasibility.h"
+
+int scheduling_point_feasibility_reduced(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+#endif
@@ -0,0 +1,258 @@
+// Sensitivity analysis for fixed priority task sets - see sensitivity.h
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rta.h"
+#include "sensitivity.h"
+
+// Per-thread probe set and response time buffers, grown as needed and reused from one call to the next
+static __thread U32_T *sens_period = NULL, *sens_wcet = NULL, *sens_deadline = NULL;
+static __thread U64_T *sens_base = NULL, *sens_bound = NULL, *sens_trial = NULL;
+static __thread U32_T sens_capacity = 0;
+
+static int sens_reserve(U32_T count)
+{
+    U32_T *p;
+    U64_T *q;
+
+    if(count <= sens_capacity)
+        return TRUE;
+
+    if((p = realloc(sens_period, count * sizeof(U32_T))) == NULL) return FALSE;
+    sens_period = p;
+    if((p = realloc(sens_wcet, count * sizeof(U32_T))) == NULL) return FALSE;
+    sens_wcet = p;
+    if((p = realloc(sens_deadline, count * sizeof(U32_T))) == NULL) return FALSE;
+    sens_deadline = p;
+    if((q = realloc(sens_base, count * sizeof(U64_T))) == NULL) return FALSE;
+    sens_base = q;
+    if((q = realloc(sens_bound, count * sizeof(U64_T))) == NULL) return FALSE;
+    sens_bound = q;
+    if((q = realloc(sens_trial, count * sizeof(U64_T))) == NULL) return FALSE;
+    sens_trial = q;
+
+    sens_capacity = count;
+    return TRUE;
+}
+
+// Copy the set into the probe buffers, returning FALSE if memory ran out
+static int sens_load(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[])
+{
+    if(!sens_reserve(numServices ? numServices : 1))
+        return FALSE;
+
+    memcpy(sens_period, period, numServices * sizeof(U32_T));
+    memcpy(sens_wcet, wcet, numServices * sizeof(U32_T));
+    memcpy(sens_deadline, deadline, numServices * sizeof(U32_T));
+    return TRUE;
+}
+
+/* Completion test of the probe set from priority level first down, returning TRUE with the response times in trial[] when every
+ * service meets its deadline.  bound[] holds lower bounds on the response times, and is exact above first where the probe
+ * changes nothing; each fixed point starts from the larger of bound[i] and R(i-1) + C(i).
+ *
+ * trial[] and bound[] hold the response times of the first jobs, which are what seed the fixed points.  A first job that
+ * completes after the next release of its service has the rest of its busy period checked as well, which a service can only
+ * need, and pass, when its deadline is beyond its period.
+ */
+static int sens_probe(U32_T numServices, U32_T first, const U64_T bound[], U64_T trial[])
+{
+    U64_T seed, r, worst;
+    U32_T i;
+
+    for(i=first; i < numServices; i++)
+    {
+        seed = bound[i];
+        if(i > 0)
+        {
+            r = ((i == first) ? bound[i-1] : trial[i-1]) + sens_wcet[i];
+            if(r > seed)
+                seed = r;
+        }
+
+        if(!rta_response_time(i, sens_period, sens_wcet, seed, sens_deadline[i], &r) || r > sens_deadline[i])
+            return FALSE;
+        if(r > sens_period[i] &&
+           (!rta_response_time_busy_period(i, NULL, sens_period, sens_wcet, sens_deadline[i], RTA_STOP_ON_MISS, &worst) ||
+            worst > sens_deadline[i]))
+            return FALSE;
+        trial[i] = r;
+    }
+
+    return TRUE;
+}
+
+// Response times of the set as given into sens_base[], returning FALSE if it is not feasible
+static int sens_baseline(U32_T numServices)
+{
+    memset(sens_base, 0, numServices * sizeof(U64_T));
+    return sens_probe(numServices, 0, sens_base, sens_base);
+}
+
+// After a feasible probe its response times are the new lower bounds
+static void sens_accept(U32_T first)
+{
+    U64_T *tmp;
+
+    memcpy(sens_trial, sens_bound, first * sizeof(U64_T));
+    tmp = sens_bound;
+    sens_bound = sens_trial;
+    sens_trial = tmp;
+}
+
+int sensitivity_wcet_limits(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                            U32_T maxWcet[])
+{
+    U32_T k, lo, hi, mid;
+
+    if(!sens_load(numServices, period, wcet, deadline))
+        return -1;
+    if(!sens_baseline(numServices))
+        return FALSE;
+
+    for(k=0; k < numServices; k++)
+    {
+        // the largest feasible C(k) is in [C(k), D(k)], since R(k) >= C(k)
+        memcpy(sens_bound, sens_base, numServices * sizeof(U64_T));
+        lo = wcet[k];
+        hi = deadline[k];
+        while(lo < hi)
+        {
+            mid = lo + (hi - lo + 1) / 2;
+            sens_wcet[k] = mid;
+            if(sens_probe(numServices, k, sens_bound, sens_trial))
+            {
+                lo = mid;
+                sens_accept(k);
+            }
+            else
+                hi = mid - 1;
+        }
+
+        sens_wcet[k] = wcet[k];
+        maxWcet[k] = lo;
+    }
+
+    return TRUE;
+}
+
+// Raise every WCET to ceil(a*C(j)), returning FALSE when one then exceeds its deadline
+static int sens_scale_wcets(U32_T numServices, const U32_T wcet[], const U32_T deadline[], double a)
+{
+    double c;
+    U32_T j;
+
+    for(j=0; j < numServices; j++)
+    {
+        c = ceil(a * (double)wcet[j]);
+        if(c > (double)deadline[j])
+            return FALSE;
+        sens_wcet[j] = (U32_T)c;
+    }
+
+    return TRUE;
+}
+
+int sensitivity_wcet_scale(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                           double *scale)
+{
+    double lo, hi, mid;
+    U32_T j, largest = 0;
+    int feasible;
+
+    if(!sens_load(numServices, period, wcet, deadline))
+        return -1;
+
+    // no WCET can grow past its deadline, which bounds the factor from above
+    hi = HUGE_VAL;
+    for(j=0; j < numServices; j++)
+    {
+        if(wcet[j] && (double)deadline[j] / (double)wcet[j] < hi)
+            hi = (double)deadline[j] / (double)wcet[j];
+        if(wcet[j] > largest)
+            largest = wcet[j];
+    }
+    if(largest == 0)
+    {
+        *scale = HUGE_VAL;
+        return sens_baseline(numServices);
+    }
+
+    memset(sens_bound, 0, numServices * sizeof(U64_T));
+    if((feasible = sens_baseline(numServices)))
+    {
+        // a feasible set is searched above 1 from its own response times
+        lo = 1.0;
+        memcpy(sens_bound, sens_base, numServices * sizeof(U64_T));
+        if(sens_scale_wcets(numServices, wcet, deadline, hi) && sens_probe(numServices, 0, sens_bound, sens_trial))
+            lo = hi;
+    }
+    else
+    {
+        // one that is not is searched below 1, down to the factor that leaves every WCET at 1 tick, below which nothing changes
+        lo = 1.0 / (double)largest;
+        hi = 1.0;
+        if(!sens_scale_wcets(numServices, wcet, deadline, lo) || !sens_probe(numServices, 0, sens_bound, sens_trial))
+        {
+            *scale = 0.0;
+            return FALSE;
+        }
+        sens_accept(0);
+    }
+
+    while(hi - lo > SENSITIVITY_SCALE_PRECISION * hi)
+    {
+        mid = 0.5 * (lo + hi);
+        if(sens_scale_wcets(numServices, wcet, deadline, mid) && sens_probe(numServices, 0, sens_bound, sens_trial))
+        {
+            lo = mid;
+            sens_accept(0);
+        }
+        else
+            hi = mid;
+    }
+
+    *scale = lo;
+    return feasible;
+}
+
+int sensitivity_period_limits(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                              U32_T minPeriod[])
+{
+    U32_T k, lo, hi, mid;
+
+    if(!sens_load(numServices, period, wcet, deadline))
+        return -1;
+    if(!sens_baseline(numServices))
+        return FALSE;
+
+    for(k=0; k < numServices; k++)
+    {
+        // the shortest feasible T(k) is in [C(k), T(k)]; the deadline only decides the check, not R(k) or the interference,
+        // and one already beyond the period is kept as it is
+        memcpy(sens_bound, sens_base, numServices * sizeof(U64_T));
+        lo = wcet[k] ? wcet[k] : 1;
+        hi = period[k];
+        while(lo < hi)
+        {
+            mid = lo + (hi - lo) / 2;
+            sens_period[k] = mid;
+            sens_deadline[k] = (deadline[k] < mid || deadline[k] > period[k]) ? deadline[k] : mid;
+            if(sens_probe(numServices, k, sens_bound, sens_trial))
+            {
+                hi = mid;
+                sens_accept(k);
+            }
+            else
+                lo = mid + 1;
+        }
+
+        sens_period[k] = period[k];
+        sens_deadline[k] = deadline[k];
+        minPeriod[k] = hi;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,42 @@
+// Sensitivity analysis for fixed priority task sets
+//
+// Rather than a feasible/infeasible answer, these find how far a set can be pushed before its first deadline miss, keeping the
+// priorities in array order (highest first) as for completion_time_feasibility:
+//
+//     sensitivity_wcet_limits    the largest C(k) of each service with the others unchanged; maxWcet[k]/C(k) is the
+//                                per-service scaling factor
+//     sensitivity_wcet_scale     the critical scaling factor, the largest a with every WCET raised to ceil(a*C(j)); below 1 for
+//                                a set that is not feasible as given, 0 if not even 1 tick WCETs are, and HUGE_VAL if every
+//                                WCET is 0
+//     sensitivity_period_limits  the shortest T(k) of each service with the others unchanged, where a deadline within the
+//                                period drops with it once it would exceed it (D'(k) = min(D(k), T'(k))) and a deadline
+//                                beyond the period stays as it is
+//
+// Each limit is a bisection over probes of the completion test, which checks the whole busy period of a service whose first job
+// runs past its next release, as rta_response_times does.  Feasibility only gets harder in the direction of the search, so the
+// probes are cheap:
+//
+//     - the response times of the most heavily loaded set known to be feasible are lower bounds for every probe still to come
+//       and seed their fixed points, so a probe only iterates over the extra interference
+//     - a change to service k cannot affect the services above it, whose response times are reused without analysis
+//     - a probe stops at its first deadline miss
+//
+// All three return TRUE when the set is feasible as given, FALSE when it is not (the per-service limits are then not computed),
+// and -1 if memory ran out.
+
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+#include "feasibility.h"
+
+// Relative width of the interval the critical scaling factor is narrowed to
+#define SENSITIVITY_SCALE_PRECISION 1e-6
+
+int sensitivity_wcet_limits(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                            U32_T maxWcet[]);
+int sensitivity_wcet_scale(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                           double *scale);
+int sensitivity_period_limits(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                              U32_T minPeriod[]);
+
+#endif
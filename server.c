@@ -0,0 +1,202 @@
+// Aperiodic server capacity analysis - see server.h
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rta.h"
+#include "server.h"
+
+const char *server_kind_names[] = {"ps", "ds", "ss"};
+
+// Per-thread copy of the set with the server inserted, grown as needed and reused from one call to the next
+static __thread U32_T *server_period = NULL, *server_wcet = NULL, *server_deadline = NULL, *server_jitter = NULL;
+static __thread U64_T *server_response = NULL;
+static __thread U32_T server_capacity = 0;
+
+static int server_reserve(U32_T count)
+{
+    U32_T *p;
+    U64_T *r;
+
+    if(count <= server_capacity)
+        return TRUE;
+
+    if((p = realloc(server_period, count * sizeof(U32_T))) == NULL) return FALSE;
+    server_period = p;
+    if((p = realloc(server_wcet, count * sizeof(U32_T))) == NULL) return FALSE;
+    server_wcet = p;
+    if((p = realloc(server_deadline, count * sizeof(U32_T))) == NULL) return FALSE;
+    server_deadline = p;
+    if((p = realloc(server_jitter, count * sizeof(U32_T))) == NULL) return FALSE;
+    server_jitter = p;
+    if((r = realloc(server_response, count * sizeof(U64_T))) == NULL) return FALSE;
+    server_response = r;
+
+    server_capacity = count;
+    return TRUE;
+}
+
+void server_default_params(server_params_t *params)
+{
+    params->kind = SERVER_SPORADIC;
+    params->period = 0;
+    params->level = 0;
+    params->demand = 0;
+}
+
+/* Parse a comma separated key=value server spec, kind=ps|ds|ss, period=Ts, level=L and demand=A, over the current values of
+ * params.  Returns TRUE, or FALSE with a description of the problem in *error.
+ */
+int server_parse_params(const char *spec, server_params_t *params, const char **error)
+{
+    static const char *keys[] = {"kind", "period", "level", "demand"};
+    const char *p = spec, *eq;
+    unsigned long long value = 0;
+    char *end;
+    size_t len;
+    int idx, kind;
+
+    while(*p)
+    {
+        if((eq = strchr(p, '=')) == NULL)
+        {
+            *error = "expected key=value";
+            return FALSE;
+        }
+        len = eq - p;
+        for(idx=0; idx < (int)(sizeof(keys)/sizeof(keys[0])); idx++)
+            if(strlen(keys[idx]) == len && strncmp(p, keys[idx], len) == 0)
+                break;
+        if(idx == (int)(sizeof(keys)/sizeof(keys[0])))
+        {
+            *error = "unknown server key";
+            return FALSE;
+        }
+
+        len = strcspn(eq + 1, ",");
+        if(idx == 0)
+        {
+            for(kind=0; kind <= SERVER_SPORADIC; kind++)
+                if(strlen(server_kind_names[kind]) == len && strncmp(eq + 1, server_kind_names[kind], len) == 0)
+                    break;
+            if(kind > SERVER_SPORADIC)
+            {
+                *error = "server kind must be ps, ds or ss";
+                return FALSE;
+            }
+            params->kind = kind;
+        }
+        else
+        {
+            errno = 0;
+            value = strtoull(eq + 1, &end, 10);
+            if(errno || end != eq + 1 + len || len == 0 || eq[1] == '-' || (idx < 3 && value > UINT_MAX))
+            {
+                *error = "bad server value";
+                return FALSE;
+            }
+        }
+
+        switch(idx)
+        {
+            case 1: params->period = (U32_T)value; break;
+            case 2: params->level = (U32_T)value; break;
+            case 3: params->demand = value; break;
+        }
+
+        p = eq + 1 + len;
+        if(*p == ',')
+            p++;
+    }
+
+    if(params->period == 0)
+    {
+        *error = "server period must be given and non-zero";
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// TRUE when the set with the server at level running budget per period meets every deadline, the server's included
+static int server_fits(U32_T numServices, U32_T level, int kind, U32_T serverPeriod, U32_T budget)
+{
+    rta_overheads_t overheads = {NULL, NULL, 0};
+    U32_T jitter = 0;
+
+    if(kind == SERVER_DEFERRABLE)
+    {
+        jitter = serverPeriod - budget;
+        overheads.jitter = server_jitter;
+    }
+
+    server_period[level] = serverPeriod;
+    server_wcet[level] = budget;
+    server_jitter[level] = jitter;
+    server_deadline[level] = (serverPeriod > UINT_MAX - jitter) ? UINT_MAX : serverPeriod + jitter;
+
+    return rta_response_times_overheads(numServices + 1, server_period, server_wcet, server_deadline, &overheads,
+                                        server_response, RTA_STOP_ON_MISS) == TRUE;
+}
+
+/* The largest budget the server described by params can have with the set meeting every deadline.  Returns TRUE with the budget,
+ * the server's response time and the aperiodic response time bound in *result, FALSE with a budget of 0 when not even a budget
+ * of 1 fits (or the set is infeasible without the server), and -1 if memory ran out.
+ */
+int server_max_budget(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                      const server_params_t *params, server_result_t *result)
+{
+    U32_T level = (params->level < numServices) ? params->level : numServices, lo = 0, hi = params->period, mid;
+
+    result->budget = 0;
+    result->response = result->aperiodic = RTA_RESPONSE_UNKNOWN;
+    if(params->period == 0)
+        return FALSE;
+    if(!server_reserve(numServices + 1))
+        return -1;
+
+    // the periodic services keep their order around the server, with no jitter of their own
+    memcpy(server_period, period, level * sizeof(U32_T));
+    memcpy(server_wcet, wcet, level * sizeof(U32_T));
+    memcpy(server_deadline, deadline, level * sizeof(U32_T));
+    memcpy(&server_period[level+1], &period[level], (numServices - level) * sizeof(U32_T));
+    memcpy(&server_wcet[level+1], &wcet[level], (numServices - level) * sizeof(U32_T));
+    memcpy(&server_deadline[level+1], &deadline[level], (numServices - level) * sizeof(U32_T));
+    memset(server_jitter, 0, (numServices + 1) * sizeof(U32_T));
+
+    // lo always fits once a budget of 1 does, and hi is the largest budget not yet ruled out
+    if(!server_fits(numServices, level, params->kind, params->period, 1))
+        return FALSE;
+    lo = 1;
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo + 1) / 2;
+        if(server_fits(numServices, level, params->kind, params->period, mid))
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    // the analysis of the budget found, for the server's own response time from its replenishment
+    server_fits(numServices, level, params->kind, params->period, lo);
+    result->budget = lo;
+    result->response = server_response[level] - server_jitter[level];
+    result->aperiodic = server_aperiodic_response(params->period, lo, result->response, params->demand);
+    return TRUE;
+}
+
+// Response time bound of an aperiodic request of the given demand (0 for one full budget) that finds no other request queued
+U64_T server_aperiodic_response(U32_T serverPeriod, U32_T budget, U64_T serverResponse, U64_T demand)
+{
+    U64_T periods, r;
+
+    if(budget == 0 || serverResponse == RTA_RESPONSE_UNKNOWN)
+        return RTA_RESPONSE_UNKNOWN;
+
+    periods = demand ? demand / budget + (demand % budget != 0) : 1;
+    if(__builtin_mul_overflow(periods, (U64_T)serverPeriod, &r) || __builtin_add_overflow(r, serverResponse, &r))
+        return RTA_RESPONSE_UNKNOWN;
+    return r;
+}
@@ -0,0 +1,59 @@
+// Aperiodic server capacity analysis
+//
+// Aperiodic requests are served by a server service of period Ts that may run up to its budget Cs per period at a chosen priority
+// level among the periodic services.  server_max_budget finds the largest budget that keeps every periodic service and the server
+// itself within its deadline, by binary search over Cs with the completion test as the check, as each kind of server interferes
+// with the services below it like a periodic service:
+//
+//     SERVER_POLLING     the polling server runs at its release only, as a periodic service (Ts, Cs, Ts)
+//     SERVER_DEFERRABLE  the deferrable server keeps its budget through the period and replenishes it in full every Ts, so its
+//                        budget can run back to back across a replenishment: a periodic service with release jitter Ts - Cs
+//                        (Strosnider, Lehoczky and Sha), whose own job only has to finish within Ts of its replenishment
+//     SERVER_SPORADIC    the sporadic server replenishes each chunk of budget Ts after that chunk became eligible, which leaves
+//                        the services below it no more interference than the periodic service (Ts, Cs, Ts) (Sprunt, Sha and
+//                        Lehoczky)
+//
+// The services are taken highest priority first in array order, with the server inserted before the service at level (after
+// all of them when level is numServices or more), and are analyzed with rta_response_times_overheads, first job only, so
+// deadlines beyond the periods are not supported.  The interference of each kind only grows with Cs, so the binary search
+// takes O(log Ts) analyses.
+//
+// server_aperiodic_response bounds the response time of an aperiodic request of the given execution demand that finds no other
+// request queued: it may wait up to Ts for the poll or the replenishment, is then served over ceil(demand/Cs) server periods,
+// and the last of those server jobs completes within the server's own response time R(s) of its release:
+//
+//     R(a) <= ceil(demand/Cs) * Ts + R(s)
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "feasibility.h"
+
+#define SERVER_POLLING 0
+#define SERVER_DEFERRABLE 1
+#define SERVER_SPORADIC 2
+
+typedef struct
+{
+    int kind;           // SERVER_*
+    U32_T period;       // Ts
+    U32_T level;        // priority level of the server, 0 for the highest
+    U64_T demand;       // aperiodic execution demand to bound the response time of, 0 for one full budget
+} server_params_t;
+
+typedef struct
+{
+    U32_T budget;       // largest Cs that fits, 0 when none does
+    U64_T response;     // the server's response time R(s) with that budget, RTA_RESPONSE_UNKNOWN without one
+    U64_T aperiodic;    // response time bound of an aperiodic request of the demand, RTA_RESPONSE_UNKNOWN without a budget
+} server_result_t;
+
+extern const char *server_kind_names[];
+
+void server_default_params(server_params_t *params);
+int server_parse_params(const char *spec, server_params_t *params, const char **error);
+int server_max_budget(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[],
+                      const server_params_t *params, server_result_t *result);
+U64_T server_aperiodic_response(U32_T serverPeriod, U32_T budget, U64_T serverResponse, U64_T demand);
+
+#endif
@@ -0,0 +1,342 @@
+// Binary columnar task set files - see setfile.h
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "setfile.h"
+
+// Sections of the writer, in file order
+#define SECTION_OFFSETS 0
+#define SECTION_PERIOD 1
+#define SECTION_WCET 2
+#define SECTION_DEADLINE 3
+#define SECTION_JITTER 4
+#define SECTION_BLOCKING 5
+#define SECTION_LABEL_OFFSETS 6
+#define SECTION_LABELS 7
+
+static inline U64_T setfile_align(U64_T x)
+{
+    return (x + SETFILE_ALIGN - 1) / SETFILE_ALIGN * SETFILE_ALIGN;
+}
+
+// TRUE when the file at path starts with the set file magic
+int setfile_is_setfile(const char *path)
+{
+    char magic[sizeof(((setfile_header_t *)0)->magic)];
+    FILE *in;
+    int is;
+
+    if((in = fopen(path, "rb")) == NULL)
+        return FALSE;
+    is = (fread(magic, 1, sizeof(magic), in) == sizeof(magic) && memcmp(magic, SETFILE_MAGIC, sizeof(magic)) == 0);
+    fclose(in);
+    return is;
+}
+
+// TRUE when a section of the given length at start lies within the file and is aligned
+static int setfile_section_ok(U64_T start, U64_T length, size_t size)
+{
+    return start % SETFILE_ALIGN == 0 && start >= sizeof(setfile_header_t) && start <= size && length <= size - start;
+}
+
+/* Map the set file at path and check it, so the sets can then be used without further checks.  Returns TRUE, or FALSE with a
+ * description of the problem in *error (errno also tells for a file that could not be opened or mapped).
+ */
+int setfile_map(setfile_t *sf, const char *path, const char **error)
+{
+    const setfile_header_t *h;
+    struct stat st;
+    U64_T idx, n;
+    int fd;
+
+    memset(sf, 0, sizeof(*sf));
+    *error = "cannot open or map the file";
+    if((fd = open(path, O_RDONLY)) < 0)
+        return FALSE;
+    if(fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(setfile_header_t))
+    {
+        if(st.st_size < (off_t)sizeof(setfile_header_t))
+            *error = "file too short for a set file header";
+        close(fd);
+        return FALSE;
+    }
+
+    sf->size = (size_t)st.st_size;
+    sf->base = mmap(NULL, sf->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(sf->base == MAP_FAILED)
+    {
+        sf->base = NULL;
+        return FALSE;
+    }
+    madvise(sf->base, sf->size, MADV_SEQUENTIAL);
+
+    h = sf->base;
+    if(memcmp(h->magic, SETFILE_MAGIC, sizeof(h->magic)) != 0)
+        *error = "not a set file";
+    else if(h->byteOrder != SETFILE_BYTE_ORDER)
+        *error = "set file written with the other byte order";
+    else if(h->version != SETFILE_VERSION)
+        *error = "unsupported set file version";
+    else if(h->fileSize != sf->size)
+        *error = "set file truncated";
+    else if(h->numSets >= sf->size / sizeof(U64_T) || h->numServices > sf->size / sizeof(U32_T))
+        *error = "set file counts larger than the file";
+    else if(!setfile_section_ok(h->offsets, (h->numSets + 1) * sizeof(U64_T), sf->size) ||
+            !setfile_section_ok(h->period, h->numServices * sizeof(U32_T), sf->size) ||
+            !setfile_section_ok(h->wcet, h->numServices * sizeof(U32_T), sf->size) ||
+            !setfile_section_ok(h->deadline, h->numServices * sizeof(U32_T), sf->size) ||
+            ((h->flags & SETFILE_OVERHEADS) && (!setfile_section_ok(h->jitter, h->numServices * sizeof(U32_T), sf->size) ||
+                                               !setfile_section_ok(h->blocking, h->numServices * sizeof(U32_T), sf->size))) ||
+            ((h->flags & SETFILE_LABELS) && (!setfile_section_ok(h->labelOffsets, (h->numSets + 1) * sizeof(U64_T), sf->size) ||
+                                            !setfile_section_ok(h->labels, 0, sf->size))))
+        *error = "set file section out of bounds";
+    else
+        *error = NULL;
+
+    if(*error)
+    {
+        setfile_unmap(sf);
+        return FALSE;
+    }
+
+    sf->flags = h->flags;
+    sf->numSets = h->numSets;
+    sf->numServices = h->numServices;
+    sf->offsets = (const U64_T *)((const char *)sf->base + h->offsets);
+    sf->period = (U32_T *)((char *)sf->base + h->period);
+    sf->wcet = (U32_T *)((char *)sf->base + h->wcet);
+    sf->deadline = (U32_T *)((char *)sf->base + h->deadline);
+    if(sf->flags & SETFILE_OVERHEADS)
+    {
+        sf->jitter = (U32_T *)((char *)sf->base + h->jitter);
+        sf->blocking = (U32_T *)((char *)sf->base + h->blocking);
+    }
+
+    // the set boundaries are checked once here rather than on every use
+    if(sf->offsets[0] != 0 || sf->offsets[sf->numSets] != sf->numServices)
+        *error = "set file offsets do not cover the services";
+    for(idx=0; !*error && idx < sf->numSets; idx++)
+    {
+        if(sf->offsets[idx+1] < sf->offsets[idx] || (n = sf->offsets[idx+1] - sf->offsets[idx]) > UINT_MAX)
+            *error = "set file offsets out of order";
+        else if(n > sf->maxServices)
+            sf->maxServices = (U32_T)n;
+    }
+
+    // and so are the values the analyses divide by or assume, which the text parser checks for every line
+    for(idx=0; !*error && idx < sf->numServices; idx++)
+    {
+        if(sf->period[idx] == 0 || sf->deadline[idx] == 0)
+            *error = "set file has a zero period or deadline";
+        else if(sf->wcet[idx] > sf->period[idx])
+            *error = "set file has a wcet longer than its period";
+    }
+
+    if(!*error && (sf->flags & SETFILE_LABELS))
+    {
+        sf->labelOffsets = (const U64_T *)((const char *)sf->base + h->labelOffsets);
+        sf->labels = (const char *)sf->base + h->labels;
+        n = sf->size - h->labels;
+        if(sf->labelOffsets[0] != 0 || sf->labelOffsets[sf->numSets] > n ||
+           (sf->numSets && sf->labels[sf->labelOffsets[sf->numSets] - 1] != '\0'))
+            *error = "set file labels out of bounds";
+        for(idx=0; !*error && idx < sf->numSets; idx++)
+            if(sf->labelOffsets[idx+1] <= sf->labelOffsets[idx])
+                *error = "set file labels out of order";
+    }
+
+    if(*error)
+    {
+        setfile_unmap(sf);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void setfile_unmap(setfile_t *sf)
+{
+    if(sf->base)
+        munmap(sf->base, sf->size);
+    memset(sf, 0, sizeof(*sf));
+}
+
+// Label of a set, "" in a file without labels
+const char *setfile_label(const setfile_t *sf, U64_T set)
+{
+    return (sf->labels) ? sf->labels + sf->labelOffsets[set] : "";
+}
+
+/* Start writing a set file at path.  Returns FALSE if it or the temporary section files could not be created (the writer then
+ * holds nothing to close).
+ */
+int setfile_create(setfile_writer_t *wr, const char *path)
+{
+    U64_T zero = 0;
+    int idx, ok;
+
+    memset(wr, 0, sizeof(*wr));
+    ok = ((wr->out = fopen(path, "wb")) != NULL);
+    for(idx=0; ok && idx < SETFILE_SECTIONS; idx++)
+        ok = ((wr->section[idx] = tmpfile()) != NULL);
+
+    ok = ok && fwrite(&zero, sizeof(zero), 1, wr->section[SECTION_OFFSETS]) == 1 &&
+         fwrite(&zero, sizeof(zero), 1, wr->section[SECTION_LABEL_OFFSETS]) == 1;
+    if(!ok)
+    {
+        for(idx=0; idx < SETFILE_SECTIONS; idx++)
+            if(wr->section[idx])
+                fclose(wr->section[idx]);
+        if(wr->out)
+        {
+            fclose(wr->out);
+            remove(path);
+        }
+        memset(wr, 0, sizeof(*wr));
+    }
+    return ok;
+}
+
+// Write count values of a column, zeros when values is NULL; FALSE on a write error
+static int setfile_write_column(FILE *out, const U32_T values[], U32_T count)
+{
+    static const U32_T zeros[256] = {0};
+    U32_T chunk;
+
+    if(values)
+        return fwrite(values, sizeof(U32_T), count, out) == count;
+
+    for(; count; count -= chunk)
+    {
+        chunk = (count < 256) ? count : 256;
+        if(fwrite(zeros, sizeof(U32_T), chunk, out) != chunk)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static int setfile_nonzero(const U32_T values[], U32_T count)
+{
+    U32_T idx;
+
+    for(idx=0; values && idx < count; idx++)
+        if(values[idx])
+            return TRUE;
+    return FALSE;
+}
+
+/* Append one set; jitter and blocking may be NULL for zeros and label NULL for none.  Returns FALSE on a write error, which
+ * also makes setfile_close fail.
+ */
+int setfile_append(setfile_writer_t *wr, const char *label, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                   const U32_T deadline[], const U32_T jitter[], const U32_T blocking[])
+{
+    size_t length = label ? strlen(label) : 0;
+    U64_T end = wr->numServices + numServices;
+    int ok;
+
+    ok = setfile_write_column(wr->section[SECTION_PERIOD], period, numServices) &&
+         setfile_write_column(wr->section[SECTION_WCET], wcet, numServices) &&
+         setfile_write_column(wr->section[SECTION_DEADLINE], deadline, numServices) &&
+         setfile_write_column(wr->section[SECTION_JITTER], jitter, numServices) &&
+         setfile_write_column(wr->section[SECTION_BLOCKING], blocking, numServices) &&
+         fwrite(&end, sizeof(end), 1, wr->section[SECTION_OFFSETS]) == 1 &&
+         fwrite(length ? label : "", 1, length + 1, wr->section[SECTION_LABELS]) == length + 1;
+
+    wr->labelBytes += length + 1;
+    ok = ok && fwrite(&wr->labelBytes, sizeof(U64_T), 1, wr->section[SECTION_LABEL_OFFSETS]) == 1;
+
+    if(setfile_nonzero(jitter, numServices) || setfile_nonzero(blocking, numServices))
+        wr->flags |= SETFILE_OVERHEADS;
+    if(length)
+        wr->flags |= SETFILE_LABELS;
+    wr->numSets++;
+    wr->numServices = end;
+    return ok;
+}
+
+// Copy a temporary section to the output; FALSE on a read or write error
+static int setfile_copy(FILE *out, FILE *in)
+{
+    char buf[1 << 16];
+    size_t n;
+
+    rewind(in);
+    while((n = fread(buf, 1, sizeof(buf), in)) > 0)
+        if(fwrite(buf, 1, n, out) != n)
+            return FALSE;
+    return !ferror(in);
+}
+
+// Pad the output with zeros up to position
+static int setfile_pad(FILE *out, U64_T position)
+{
+    long at = ftell(out);
+
+    for(; at >= 0 && (U64_T)at < position; at++)
+        if(fputc(0, out) == EOF)
+            return FALSE;
+    return at >= 0;
+}
+
+/* Lay out the sections after the header, write the file and release the writer.  Returns FALSE if anything could not be
+ * written, including an earlier failed append.
+ */
+int setfile_close(setfile_writer_t *wr)
+{
+    setfile_header_t h;
+    U64_T *start[SETFILE_SECTIONS], length[SETFILE_SECTIONS], at;
+    int idx, ok = TRUE;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SETFILE_MAGIC, sizeof(h.magic));
+    h.version = SETFILE_VERSION;
+    h.byteOrder = SETFILE_BYTE_ORDER;
+    h.flags = wr->flags;
+    h.numSets = wr->numSets;
+    h.numServices = wr->numServices;
+
+    start[SECTION_OFFSETS] = &h.offsets;
+    start[SECTION_PERIOD] = &h.period;
+    start[SECTION_WCET] = &h.wcet;
+    start[SECTION_DEADLINE] = &h.deadline;
+    start[SECTION_JITTER] = &h.jitter;
+    start[SECTION_BLOCKING] = &h.blocking;
+    start[SECTION_LABEL_OFFSETS] = &h.labelOffsets;
+    start[SECTION_LABELS] = &h.labels;
+    for(idx=0; idx < SETFILE_SECTIONS; idx++)
+        length[idx] = (idx == SECTION_OFFSETS || idx == SECTION_LABEL_OFFSETS) ? (wr->numSets + 1) * sizeof(U64_T) :
+                      (idx == SECTION_LABELS) ? wr->labelBytes : wr->numServices * sizeof(U32_T);
+
+    // the optional sections are only kept when some set needed them
+    at = setfile_align(sizeof(h));
+    for(idx=0; idx < SETFILE_SECTIONS; idx++)
+    {
+        if(((idx == SECTION_JITTER || idx == SECTION_BLOCKING) && !(wr->flags & SETFILE_OVERHEADS)) ||
+           ((idx == SECTION_LABEL_OFFSETS || idx == SECTION_LABELS) && !(wr->flags & SETFILE_LABELS)))
+            continue;
+        *start[idx] = at;
+        at = setfile_align(at + length[idx]);
+    }
+    h.fileSize = at;
+
+    ok = fwrite(&h, sizeof(h), 1, wr->out) == 1;
+    for(idx=0; idx < SETFILE_SECTIONS; idx++)
+    {
+        if(ok && *start[idx])
+            ok = setfile_pad(wr->out, *start[idx]) && setfile_copy(wr->out, wr->section[idx]);
+        ok = ok && !ferror(wr->section[idx]);
+        fclose(wr->section[idx]);
+    }
+    ok = ok && setfile_pad(wr->out, h.fileSize);
+    ok = (fclose(wr->out) == 0) && ok;
+
+    memset(wr, 0, sizeof(*wr));
+    return ok;
+}
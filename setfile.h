@@ -0,0 +1,100 @@
+// Binary columnar task set files
+//
+// Parsing the text input costs more than the fast tests themselves, so large corpora can be kept in a binary file laid out the
+// way batch mode holds sets in memory, and mapped rather than read:
+//
+//     header      setfile_header_t: magic, version, byte order mark, counts and the start of each section below
+//     offsets     U64_T[numSets+1]: the services of set i are entries offsets[i]..offsets[i+1]-1 of every column
+//     period      U32_T[numServices]
+//     wcet        U32_T[numServices]
+//     deadline    U32_T[numServices]
+//     jitter      U32_T[numServices], only with SETFILE_OVERHEADS
+//     blocking    U32_T[numServices], only with SETFILE_OVERHEADS
+//     labels      U64_T[numSets+1] offsets into a pool of NUL terminated labels, only with SETFILE_LABELS
+//
+// Every section starts on a 64-byte boundary and the values are in the byte order of the machine that wrote the file (files
+// from the other byte order are rejected).  setfile_map checks the header, the offsets and the values once (every period and
+// deadline non-zero, and no WCET longer than its period), so the columns can then be used in place with no per-set parsing,
+// copying or allocation.  The writer streams each section to a temporary file and assembles them on close, so converting a
+// corpus of any size takes no more memory than one set.  It leaves out the jitter, blocking and label sections when every set
+// has them zero or empty.
+
+#ifndef SETFILE_H
+#define SETFILE_H
+
+#include <stdio.h>
+
+#include "feasibility.h"
+
+#define SETFILE_MAGIC "FEASSETS"
+#define SETFILE_VERSION 1
+#define SETFILE_BYTE_ORDER 0x01020304U
+
+// Section flags of a file
+#define SETFILE_OVERHEADS 0x1
+#define SETFILE_LABELS 0x2
+
+#define SETFILE_ALIGN 64
+
+typedef struct
+{
+    char magic[8];
+    U32_T version;
+    U32_T byteOrder;
+    U32_T flags;
+    U32_T reserved;
+    U64_T numSets;
+    U64_T numServices;
+    U64_T fileSize;
+    U64_T offsets;              // start of each section from the start of the file, 0 when the section is absent
+    U64_T period;
+    U64_T wcet;
+    U64_T deadline;
+    U64_T jitter;
+    U64_T blocking;
+    U64_T labelOffsets;
+    U64_T labels;
+} setfile_header_t;
+
+// A mapped file; the columns are writable, but the mapping is private, so changes never reach the file
+typedef struct
+{
+    void *base;
+    size_t size;
+    U32_T flags;
+    U64_T numSets;
+    U64_T numServices;
+    U32_T maxServices;          // the most services in one set
+    const U64_T *offsets;
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *jitter;              // NULL without SETFILE_OVERHEADS
+    U32_T *blocking;
+    const U64_T *labelOffsets;  // NULL without SETFILE_LABELS
+    const char *labels;
+} setfile_t;
+
+#define SETFILE_SECTIONS 8
+
+typedef struct
+{
+    FILE *out;
+    FILE *section[SETFILE_SECTIONS];    // offsets, the five columns, label offsets and labels, as they are appended
+    U32_T flags;                // the optional sections that turned out to be needed: nonzero jitter or blocking, labels
+    U64_T numSets;
+    U64_T numServices;
+    U64_T labelBytes;
+} setfile_writer_t;
+
+int setfile_is_setfile(const char *path);
+int setfile_map(setfile_t *sf, const char *path, const char **error);
+void setfile_unmap(setfile_t *sf);
+const char *setfile_label(const setfile_t *sf, U64_T set);
+
+int setfile_create(setfile_writer_t *wr, const char *path);
+int setfile_append(setfile_writer_t *wr, const char *label, U32_T numServices, const U32_T period[], const U32_T wcet[],
+                   const U32_T deadline[], const U32_T jitter[], const U32_T blocking[]);
+int setfile_close(setfile_writer_t *wr);
+
+#endif
@@ -0,0 +1,425 @@
+// Event driven single core schedule simulator - see sim.h
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+
+#define SIM_NEVER (~0ULL)
+#define NOT_QUEUED (~0U)
+
+const char *sim_policy_names[] = {"rm", "dm", "edf", "llf"};
+const char *sim_tie_names[] = {"index", "running", "deadline"};
+
+typedef struct
+{
+    U32_T task;
+    U32_T heapPos;      // position in the ready heap, NOT_QUEUED when it is not waiting
+    U64_T seq;          // job number within its service, identifies the job when its slot is reused
+    U64_T deadline;     // absolute deadline
+    U64_T remaining;    // execution still needed, 0 when the slot is free
+} sim_job_t;
+
+typedef struct
+{
+    int policy;
+    int tieBreak;
+    const U32_T *period;
+    const U32_T *deadline;
+    sim_job_t *jobs;        // each service has enough slots for every job that can be pending at once
+    U32_T *slotBase;
+    U32_T *slotCount;
+    U64_T *nextRelease;
+    U64_T *jobNumber;
+    U32_T *ready;           // binary heap of job slots, highest priority first
+    U32_T numReady;
+    U32_T *releases;        // binary heap of services, earliest next release first
+    U32_T numReleases;
+} sim_t;
+
+static U64_T gcd(U64_T a, U64_T b)
+{
+    U64_T t;
+
+    while(b)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// LCM of the periods, or 0 if it does not fit in 64 bits
+U64_T sim_hyperperiod(U32_T numServices, const U32_T period[])
+{
+    U64_T h = 1;
+    U32_T i;
+
+    for(i=0; i < numServices; i++)
+        if(__builtin_mul_overflow(h / gcd(h, period[i]), (U64_T)period[i], &h))
+            return 0;
+
+    return h;
+}
+
+// Priority key of a job: lower runs first.  For LLF the key is deadline - remaining, which is the laxity plus the current time,
+// so it stays fixed while the job waits and comparing keys compares laxities.
+static inline long long sim_key(const sim_t *sim, const sim_job_t *job)
+{
+    switch(sim->policy)
+    {
+        case SIM_RM:  return sim->period[job->task];
+        case SIM_DM:  return sim->deadline[job->task];
+        case SIM_EDF: return (long long)job->deadline;
+        default:      return (long long)job->deadline - (long long)job->remaining;
+    }
+}
+
+// TRUE when job a has priority over job b
+static inline int sim_before(const sim_t *sim, U32_T a, U32_T b)
+{
+    const sim_job_t *ja = &sim->jobs[a], *jb = &sim->jobs[b];
+    long long ka = sim_key(sim, ja), kb = sim_key(sim, jb);
+
+    if(ka != kb)
+        return ka < kb;
+    if(sim->tieBreak == SIM_TIE_DEADLINE && ja->deadline != jb->deadline)
+        return ja->deadline < jb->deadline;
+    if(ja->task != jb->task)
+        return ja->task < jb->task;
+    return ja->seq < jb->seq;
+}
+
+// TRUE when waiting job a should preempt the running job b: under SIM_TIE_INDEX whenever it has priority, otherwise only when
+// it wins before the running job's turn in the tie breaking
+static inline int sim_preempts(const sim_t *sim, U32_T a, U32_T b)
+{
+    const sim_job_t *ja = &sim->jobs[a], *jb = &sim->jobs[b];
+    long long ka, kb;
+
+    if(sim->tieBreak == SIM_TIE_INDEX)
+        return sim_before(sim, a, b);
+
+    ka = sim_key(sim, ja);
+    kb = sim_key(sim, jb);
+    if(ka != kb)
+        return ka < kb;
+    return sim->tieBreak == SIM_TIE_DEADLINE && ja->deadline < jb->deadline;
+}
+
+static void ready_swap(sim_t *sim, U32_T a, U32_T b)
+{
+    U32_T tmp = sim->ready[a];
+
+    sim->ready[a] = sim->ready[b];
+    sim->ready[b] = tmp;
+    sim->jobs[sim->ready[a]].heapPos = a;
+    sim->jobs[sim->ready[b]].heapPos = b;
+}
+
+static void ready_sift_up(sim_t *sim, U32_T pos)
+{
+    while(pos > 0 && sim_before(sim, sim->ready[pos], sim->ready[(pos-1)/2]))
+    {
+        ready_swap(sim, pos, (pos-1)/2);
+        pos = (pos-1)/2;
+    }
+}
+
+static void ready_sift_down(sim_t *sim, U32_T pos)
+{
+    U32_T child;
+
+    while((child = 2*pos + 1) < sim->numReady)
+    {
+        if(child + 1 < sim->numReady && sim_before(sim, sim->ready[child+1], sim->ready[child]))
+            child++;
+        if(!sim_before(sim, sim->ready[child], sim->ready[pos]))
+            break;
+        ready_swap(sim, pos, child);
+        pos = child;
+    }
+}
+
+static void ready_push(sim_t *sim, U32_T job)
+{
+    sim->ready[sim->numReady] = job;
+    sim->jobs[job].heapPos = sim->numReady++;
+    ready_sift_up(sim, sim->numReady - 1);
+}
+
+static void ready_remove(sim_t *sim, U32_T job)
+{
+    U32_T pos = sim->jobs[job].heapPos;
+
+    sim->numReady--;
+    if(pos != sim->numReady)
+    {
+        ready_swap(sim, pos, sim->numReady);
+        ready_sift_down(sim, pos);
+        ready_sift_up(sim, pos);
+    }
+    sim->jobs[job].heapPos = NOT_QUEUED;
+}
+
+static inline int release_before(const sim_t *sim, U32_T a, U32_T b)
+{
+    if(sim->nextRelease[a] != sim->nextRelease[b])
+        return sim->nextRelease[a] < sim->nextRelease[b];
+    return a < b;
+}
+
+// Restore the release heap after the earliest service's next release moved later (or it was removed)
+static void release_sift_down(sim_t *sim)
+{
+    U32_T pos = 0, child, tmp;
+
+    while((child = 2*pos + 1) < sim->numReleases)
+    {
+        if(child + 1 < sim->numReleases && release_before(sim, sim->releases[child+1], sim->releases[child]))
+            child++;
+        if(!release_before(sim, sim->releases[child], sim->releases[pos]))
+            break;
+        tmp = sim->releases[pos];
+        sim->releases[pos] = sim->releases[child];
+        sim->releases[child] = tmp;
+        pos = child;
+    }
+}
+
+static void sim_free(sim_t *sim)
+{
+    free(sim->jobs);
+    free(sim->slotBase);
+    free(sim->slotCount);
+    free(sim->nextRelease);
+    free(sim->jobNumber);
+    free(sim->ready);
+    free(sim->releases);
+}
+
+static int sim_init(sim_t *sim, U32_T numServices, const U32_T period[], const U32_T deadline[], int policy, int tieBreak)
+{
+    U32_T i, numSlots = 0;
+
+    memset(sim, 0, sizeof(*sim));
+    sim->policy = policy;
+    sim->tieBreak = tieBreak;
+    sim->period = period;
+    sim->deadline = deadline;
+
+    sim->slotBase = malloc(numServices * sizeof(U32_T));
+    sim->slotCount = malloc(numServices * sizeof(U32_T));
+    sim->nextRelease = calloc(numServices, sizeof(U64_T));
+    sim->jobNumber = calloc(numServices, sizeof(U64_T));
+    sim->releases = malloc(numServices * sizeof(U32_T));
+    if(!sim->slotBase || !sim->slotCount || !sim->nextRelease || !sim->jobNumber || !sim->releases)
+        return FALSE;
+
+    // a job is dropped at its deadline, so at most ceil(D/T) jobs of a service are ever pending together
+    for(i=0; i < numServices; i++)
+    {
+        sim->slotBase[i] = numSlots;
+        sim->slotCount[i] = deadline[i] / period[i] + (deadline[i] % period[i] != 0);
+        numSlots += sim->slotCount[i];
+        sim->releases[i] = i;
+    }
+    sim->numReleases = numServices;
+
+    sim->jobs = calloc(numSlots, sizeof(sim_job_t));
+    sim->ready = malloc(numSlots * sizeof(U32_T));
+    if(!sim->jobs || !sim->ready)
+        return FALSE;
+    for(i=0; i < numSlots; i++)
+        sim->jobs[i].heapPos = NOT_QUEUED;
+
+    return TRUE;
+}
+
+void sim_default_options(sim_options_t *opts)
+{
+    opts->tieBreak = SIM_TIE_INDEX;
+    opts->laxityQuantum = 1;
+    opts->switchCost = 0;
+}
+
+/* Simulate the set under policy with releases in [0, horizon) (pass 0 for one hyperperiod), with the default options.  Returns
+ * TRUE when no deadline was missed, FALSE when one was, and -1 (with result zeroed) if the hyperperiod overflows or memory ran
+ * out.  result may be NULL.
+ */
+int sim_run(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy, U64_T horizon,
+            sim_result_t *result)
+{
+    return sim_run_options(numServices, period, wcet, deadline, policy, horizon, NULL, result);
+}
+
+// As sim_run, with the tie breaking, LLF laxity quantum and context switch cost of opts (NULL for the defaults)
+int sim_run_options(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy,
+                    U64_T horizon, const sim_options_t *opts, sim_result_t *result)
+{
+    sim_result_t r;
+    sim_options_t defaults;
+    sim_t sim;
+    sim_job_t *job;
+    U64_T t = 0, next, cross, quantum, lastSeq = SIM_NEVER;
+    U32_T task, slot, running = NOT_QUEUED, lastTask = NOT_QUEUED, top;
+
+    memset(&r, 0, sizeof(r));
+    if(result)
+        *result = r;
+
+    if(!opts)
+    {
+        sim_default_options(&defaults);
+        opts = &defaults;
+    }
+    quantum = opts->laxityQuantum ? opts->laxityQuantum : 1;
+
+    if(horizon == 0 && (horizon = sim_hyperperiod(numServices, period)) == 0)
+        return -1;
+    r.horizon = horizon;
+
+    if(!sim_init(&sim, numServices, period, deadline, policy, opts->tieBreak))
+    {
+        sim_free(&sim);
+        return -1;
+    }
+
+    while(1)
+    {
+        r.events++;
+
+        // release every job due now; an older job still holding the slot is past its deadline
+        while(sim.numReleases && sim.nextRelease[task = sim.releases[0]] == t)
+        {
+            slot = sim.slotBase[task] + sim.jobNumber[task] % sim.slotCount[task];
+            job = &sim.jobs[slot];
+            if(job->remaining)
+            {
+                ready_remove(&sim, slot);
+                r.deadlineMisses++;
+            }
+
+            job->task = task;
+            job->seq = sim.jobNumber[task]++;
+            job->deadline = t + deadline[task];
+            job->remaining = wcet[task];
+            r.jobsReleased++;
+            if(job->remaining)
+                ready_push(&sim, slot);
+            else
+                r.jobsCompleted++;
+
+            sim.nextRelease[task] += period[task];
+            if(sim.nextRelease[task] >= horizon)
+                sim.releases[0] = sim.releases[--sim.numReleases];
+            release_sift_down(&sim);
+        }
+
+        // jobs that expired while waiting are dropped when they reach the front
+        while(sim.numReady && sim.jobs[sim.ready[0]].deadline <= t)
+        {
+            top = sim.ready[0];
+            ready_remove(&sim, top);
+            sim.jobs[top].remaining = 0;
+            r.deadlineMisses++;
+        }
+
+        // dispatch, preempting the running job if the front of the queue now has priority over it
+        if(sim.numReady && (running == NOT_QUEUED || sim_preempts(&sim, sim.ready[0], running)))
+        {
+            if(running != NOT_QUEUED)
+            {
+                ready_push(&sim, running);
+                r.preemptions++;
+            }
+            running = sim.ready[0];
+            ready_remove(&sim, running);
+        }
+        if(running != NOT_QUEUED && (sim.jobs[running].task != lastTask || sim.jobs[running].seq != lastSeq))
+        {
+            r.contextSwitches++;
+            lastTask = sim.jobs[running].task;
+            lastSeq = sim.jobs[running].seq;
+
+            // the switch is paid for by the job switched to, before it makes any progress
+            sim.jobs[running].remaining += opts->switchCost;
+            r.overheadTime += opts->switchCost;
+        }
+
+        // next event: a release, or the running job completing, reaching its deadline or losing on laxity
+        next = sim.numReleases ? sim.nextRelease[sim.releases[0]] : SIM_NEVER;
+        if(running != NOT_QUEUED)
+        {
+            job = &sim.jobs[running];
+            if(t + job->remaining < next)
+                next = t + job->remaining;
+            if(job->deadline < next)
+                next = job->deadline;
+
+            if(policy == SIM_LLF && sim.numReady)
+            {
+                // the running job's key grows by one per tick while the waiting jobs' keys stay put; the laxities are only
+                // compared again at the next quantum boundary from there
+                cross = t + (U64_T)(sim_key(&sim, &sim.jobs[sim.ready[0]]) - sim_key(&sim, job)) + 1;
+                cross = (cross + quantum - 1) / quantum * quantum;
+                if(cross < next)
+                    next = cross;
+            }
+        }
+        else if(next == SIM_NEVER)
+            break;
+
+        if(running != NOT_QUEUED)
+        {
+            job = &sim.jobs[running];
+            job->remaining -= next - t;
+            r.busyTime += next - t;
+        }
+        t = next;
+
+        if(running != NOT_QUEUED)
+        {
+            job = &sim.jobs[running];
+            if(job->remaining == 0)
+            {
+                r.jobsCompleted++;
+                running = NOT_QUEUED;
+            }
+            else if(job->deadline <= t)
+            {
+                job->remaining = 0;
+                r.deadlineMisses++;
+                running = NOT_QUEUED;
+            }
+        }
+    }
+
+    r.endTime = t;
+    sim_free(&sim);
+    if(result)
+        *result = r;
+
+    return (r.deadlineMisses == 0);
+}
+
+int sim_rm_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return sim_run(numServices, period, wcet, deadline, SIM_RM, 0, NULL) == TRUE;
+}
+
+int sim_dm_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return sim_run(numServices, period, wcet, deadline, SIM_DM, 0, NULL) == TRUE;
+}
+
+int sim_edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return sim_run(numServices, period, wcet, deadline, SIM_EDF, 0, NULL) == TRUE;
+}
+
+int sim_llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    return sim_run(numServices, period, wcet, deadline, SIM_LLF, 0, NULL) == TRUE;
+}
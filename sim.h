@@ -0,0 +1,80 @@
+// Event driven single core schedule simulator for RM, DM, EDF and LLF
+//
+// Rather than stepping tick by tick, the simulator jumps straight to the next event: a release, the running job completing or
+// reaching its deadline, or (for LLF) a waiting job's laxity dropping below the running job's.  Ready jobs are kept in a binary
+// heap keyed by the policy's priority (period, relative deadline, absolute deadline or laxity) and releases in a second heap
+// keyed by release time, so the cost is proportional to the number of jobs rather than the length of the hyperperiod.
+//
+// All services are released together at time 0 (the critical instant) and jobs are released for one hyperperiod, then the
+// simulation runs until every released job has completed or missed.  A job that reaches its deadline unfinished is counted
+// as a miss and dropped.  LLF preempts when a waiting job's laxity becomes strictly smaller than the running job's.
+//
+// sim_options_t sets how the scheduler behaves where the policies leave it open, which is where their overhead comes from:
+//
+//     tieBreak       between jobs with equal priority keys (equal laxities under LLF, equal absolute deadlines under EDF):
+//                    SIM_TIE_INDEX     the lower service index, then the older job, even if that preempts the running job
+//                    SIM_TIE_RUNNING   the running job keeps the core, so a tie never preempts; otherwise as SIM_TIE_INDEX
+//                    SIM_TIE_DEADLINE  the earlier absolute deadline, then the running job (LLF with EDF tie breaking)
+//                    Under LLF this decides between laxities that are equal when the scheduler runs; between those events
+//                    a running job is only preempted once a waiting job's laxity is strictly smaller
+//     laxityQuantum  LLF compares laxities only at multiples of the quantum, so two jobs with tied laxities take turns for a
+//                    quantum each rather than every tick.  Releases and completions still reschedule at once.  0 or 1 for
+//                    every tick
+//     switchCost     ticks charged to a job each time it is dispatched after a different job ran, preemptions and the
+//                    resumptions after them included.  The cost counts against the job's deadline and in busyTime
+//
+// sim_run uses SIM_TIE_INDEX, quantum 1 and no switch cost, which is what the sim-* tests report by default.
+
+#ifndef SIM_H
+#define SIM_H
+
+#include "feasibility.h"
+
+// Scheduling policies
+#define SIM_RM 0
+#define SIM_DM 1
+#define SIM_EDF 2
+#define SIM_LLF 3
+
+// Tie breaking between equal priority keys
+#define SIM_TIE_INDEX 0
+#define SIM_TIE_RUNNING 1
+#define SIM_TIE_DEADLINE 2
+
+typedef struct
+{
+    int tieBreak;           // SIM_TIE_*
+    U64_T laxityQuantum;    // LLF laxity comparisons at multiples of this, 0 or 1 for every tick
+    U32_T switchCost;       // ticks charged per context switch
+} sim_options_t;
+
+typedef struct
+{
+    U64_T horizon;          // releases happen in [0, horizon)
+    U64_T endTime;          // time the last job completed or was dropped
+    U64_T jobsReleased;
+    U64_T jobsCompleted;
+    U64_T deadlineMisses;
+    U64_T preemptions;      // running job displaced before completing
+    U64_T contextSwitches;  // dispatches of a job other than the one that last ran
+    U64_T overheadTime;     // ticks spent on context switches, included in busyTime
+    U64_T busyTime;
+    U64_T events;
+} sim_result_t;
+
+extern const char *sim_policy_names[];
+extern const char *sim_tie_names[];
+
+U64_T sim_hyperperiod(U32_T numServices, const U32_T period[]);
+int sim_run(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy, U64_T horizon,
+            sim_result_t *result);
+void sim_default_options(sim_options_t *opts);
+int sim_run_options(U32_T numServices, const U32_T period[], const U32_T wcet[], const U32_T deadline[], int policy,
+                    U64_T horizon, const sim_options_t *opts, sim_result_t *result);
+
+int sim_rm_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int sim_dm_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int sim_edf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int sim_llf_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+
+#endif
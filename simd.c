@@ -0,0 +1,221 @@
+// Vectorized interference sums - see simd.h
+
+#include "simd.h"
+
+#if !defined(FEASIBILITY_NO_SIMD) && defined(__x86_64__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#elif !defined(FEASIBILITY_NO_SIMD) && defined(__aarch64__)
+#define SIMD_ARM 1
+#include <arm_neon.h>
+#endif
+
+// Elements between checks of the running sum against the limit, a multiple of every vector width
+#define SIMD_CHECK_STRIDE 32
+
+typedef int (*simd_u32_fn)(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T *sum, U64_T limit);
+
+const char *simd_level_names[] = {"scalar", "neon", "avx2", "avx512"};
+
+int simd_level = SIMD_SCALAR;
+
+/* The kernels take the running sum in *sum, seeded with the base, and return FALSE if the result leaves the exact range.  The
+ * vector loops cover whole vectors from the front of the arrays and leave the services after the last one to the scalar tails.
+ */
+
+// Add the services from j on in 64-bit integer arithmetic, which is exact up to overflow
+static int tail_u32(const U32_T period[], const U32_T wcet[], U32_T j, U32_T count, U64_T t, U64_T *sum, U64_T limit)
+{
+    U64_T term, s = *sum;
+
+    for(; j < count && s <= limit; j++)
+        if(__builtin_mul_overflow(t / period[j] + (t % period[j] != 0), (U64_T)wcet[j], &term) ||
+           __builtin_add_overflow(s, term, &s))
+            return FALSE;
+
+    *sum = s;
+    return TRUE;
+}
+
+static int scalar_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T *sum, U64_T limit)
+{
+    return tail_u32(period, wcet, 0, count, t, sum, limit);
+}
+
+/* Fold a vector partial sum into *sum.  A lane sum at or above the exact range may have been rounded, but then so is the total,
+ * which is rejected.
+ */
+static inline int fold_sum(double lanes, U64_T *sum)
+{
+    if(!(lanes < (double)SIMD_EXACT_LIMIT))
+        return FALSE;
+
+    *sum += (U64_T)lanes;
+    return *sum < SIMD_EXACT_LIMIT;
+}
+
+#ifdef SIMD_X86
+
+__attribute__((target("avx512f")))
+static int avx512_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T *sum, U64_T limit)
+{
+    __m512d vt = _mm512_set1_pd((double)t), acc = _mm512_setzero_pd(), p, c, q;
+    U64_T base = *sum;
+    U32_T j;
+
+    for(j=0; j + 8 <= count; j += 8)
+    {
+        p = _mm512_cvtepu32_pd(_mm256_loadu_si256((const __m256i *)&period[j]));
+        c = _mm512_cvtepu32_pd(_mm256_loadu_si256((const __m256i *)&wcet[j]));
+        q = _mm512_roundscale_pd(_mm512_div_pd(vt, p), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        acc = _mm512_fmadd_pd(q, c, acc);
+
+        if(((j + 8) % SIMD_CHECK_STRIDE) == 0)
+        {
+            *sum = base;
+            if(!fold_sum(_mm512_reduce_add_pd(acc), sum))
+                return FALSE;
+            if(*sum > limit)
+                return TRUE;
+        }
+    }
+
+    *sum = base;
+    if(!fold_sum(_mm512_reduce_add_pd(acc), sum))
+        return FALSE;
+    return tail_u32(period, wcet, j, count, t, sum, limit);
+}
+
+__attribute__((target("avx2,fma")))
+static inline double avx2_reduce(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+__attribute__((target("avx2,fma")))
+static int avx2_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T *sum, U64_T limit)
+{
+    __m256d vt = _mm256_set1_pd((double)t), acc = _mm256_setzero_pd(), offset = _mm256_set1_pd(2147483648.0), p, c, q;
+    __m128i sign = _mm_set1_epi32((int)0x80000000);
+    U64_T base = *sum;
+    U32_T j;
+
+    for(j=0; j + 4 <= count; j += 4)
+    {
+        // there is no unsigned conversion before AVX-512, so flip the sign bit, convert and add 2^31 back
+        p = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(_mm_loadu_si128((const __m128i *)&period[j]), sign)), offset);
+        c = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(_mm_loadu_si128((const __m128i *)&wcet[j]), sign)), offset);
+        q = _mm256_round_pd(_mm256_div_pd(vt, p), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+        acc = _mm256_fmadd_pd(q, c, acc);
+
+        if(((j + 4) % SIMD_CHECK_STRIDE) == 0)
+        {
+            *sum = base;
+            if(!fold_sum(avx2_reduce(acc), sum))
+                return FALSE;
+            if(*sum > limit)
+                return TRUE;
+        }
+    }
+
+    *sum = base;
+    if(!fold_sum(avx2_reduce(acc), sum))
+        return FALSE;
+    return tail_u32(period, wcet, j, count, t, sum, limit);
+}
+
+#endif
+
+#ifdef SIMD_ARM
+
+static int neon_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T *sum, U64_T limit)
+{
+    float64x2_t vt = vdupq_n_f64((double)t), acc = vdupq_n_f64(0.0), p, c, q;
+    U64_T base = *sum;
+    U32_T j;
+
+    for(j=0; j + 2 <= count; j += 2)
+    {
+        p = vcvtq_f64_u64(vmovl_u32(vld1_u32(&period[j])));
+        c = vcvtq_f64_u64(vmovl_u32(vld1_u32(&wcet[j])));
+        q = vrndpq_f64(vdivq_f64(vt, p));
+        acc = vfmaq_f64(acc, q, c);
+
+        if(((j + 2) % SIMD_CHECK_STRIDE) == 0)
+        {
+            *sum = base;
+            if(!fold_sum(vaddvq_f64(acc), sum))
+                return FALSE;
+            if(*sum > limit)
+                return TRUE;
+        }
+    }
+
+    *sum = base;
+    if(!fold_sum(vaddvq_f64(acc), sum))
+        return FALSE;
+    return tail_u32(period, wcet, j, count, t, sum, limit);
+}
+
+#endif
+
+static simd_u32_fn simd_u32_kernel = scalar_u32;
+
+// The highest level this processor runs
+int simd_best_level(void)
+{
+#if defined(SIMD_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return SIMD_AVX512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return SIMD_AVX2;
+#elif defined(SIMD_ARM)
+    return SIMD_NEON;
+#endif
+    return SIMD_SCALAR;
+}
+
+/* Use the kernel of level, or the best one below it that this processor runs, returning the level selected.  Switches every
+ * thread, so it belongs before any analysis starts.
+ */
+int simd_select(int level)
+{
+    int best = simd_best_level();
+
+    if(level > best)
+        level = best;
+
+    switch(level)
+    {
+#if defined(SIMD_X86)
+        case SIMD_AVX512: simd_u32_kernel = avx512_u32; break;
+        case SIMD_AVX2:   simd_u32_kernel = avx2_u32;   break;
+#elif defined(SIMD_ARM)
+        case SIMD_AVX512:
+        case SIMD_AVX2:
+        case SIMD_NEON:   level = SIMD_NEON;  simd_u32_kernel = neon_u32; break;
+#endif
+        default:          level = SIMD_SCALAR; simd_u32_kernel = scalar_u32; break;
+    }
+
+    simd_level = level;
+    return level;
+}
+
+__attribute__((constructor))
+static void simd_init(void)
+{
+    simd_select(SIMD_AVX512);
+}
+
+int simd_demand_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T base, U64_T limit, U64_T *demand)
+{
+    if(t >= SIMD_EXACT_LIMIT || base >= SIMD_EXACT_LIMIT)
+        return FALSE;
+
+    *demand = base;
+    return simd_u32_kernel(period, wcet, count, t, demand, limit);
+}
@@ -0,0 +1,57 @@
+// Vectorized interference sums for the fixed priority tests
+//
+// The inner loop of both the completion test and the scheduling point test is the same reduction over the higher priority
+// services of a window of length t:
+//
+//     base + sum over j < count of ceil(t/T(j))*C(j)
+//
+// Over the column layout of the U32_T API this maps directly onto SIMD lanes: convert T(j) and C(j) to double, form the
+// ceiling, multiply and accumulate.  Every value involved is an integer, so the double arithmetic is exact while they stay below
+// 2^51 (SIMD_EXACT_LIMIT):
+//
+//     - ceil(t/T) is taken of the correctly rounded quotient, which for t < 2^52 can only round to an integer when the quotient
+//       is one
+//     - the products and the partial sums are all no larger than the total, which is checked against the limit at the end
+//
+// A sum that would leave the exact range is reported rather than approximated, and the callers fall back to their scalar loops,
+// so the results are bit for bit those of the integer code.
+//
+// The kernels run only over the U32_T columns the analyses take.  There is no 64-bit column layout to vectorize any more: it
+// went with the taskset_t container, which no analysis used, so each lane converts 32-bit integers and the 64-bit path was
+// dropped rather than kept without a caller.
+//
+// The kernel is chosen once at load time from the instruction sets the processor supports: AVX-512F (8 lanes) or AVX2 with
+// FMA (4 lanes) on x86-64, Advanced SIMD (2 lanes) on AArch64, and a portable scalar loop otherwise.  simd_select can force a
+// lower level, for benchmarking the kernels against each other; building with -DFEASIBILITY_NO_SIMD leaves only the scalar one.
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "feasibility.h"
+
+#define SIMD_SCALAR 0
+#define SIMD_NEON 1
+#define SIMD_AVX2 2
+#define SIMD_AVX512 3
+
+// Sums and window lengths at or above this are beyond the exact range of the kernels
+#define SIMD_EXACT_LIMIT (1ULL << 51)
+
+// Below this many higher priority services the scalar loops of the callers are at least as fast
+#define SIMD_MIN_SERVICES 8
+
+extern const char *simd_level_names[];
+
+// The kernel in use, SIMD_SCALAR when none of the vector kernels can run on this processor
+extern int simd_level;
+
+int simd_best_level(void);
+int simd_select(int level);
+
+/* The interference sum: TRUE with *demand = base + sum over j < count of ceil(t/T(j))*C(j), or FALSE if that cannot be formed
+ * exactly.  The sum is abandoned once it exceeds limit, *demand is then a partial sum that is still more than limit (pass ~0ULL
+ * for the full sum).
+ */
+int simd_demand_u32(const U32_T period[], const U32_T wcet[], U32_T count, U64_T t, U64_T base, U64_T limit, U64_T *demand);
+
+#endif
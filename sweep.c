@@ -0,0 +1,549 @@
+// Acceptance ratio and breakdown utilization sweeps - see sweep.h
+
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+#include "gen.h"
+#include "parallel.h"
+#include "priority.h"
+#include "sweep.h"
+#include "tiered.h"
+
+#define SWEEP_MAX_SIZES 32
+#define SWEEP_MAX_TESTS 16
+#define DEFAULT_SWEEP_TESTS "lub,tier,qpa"
+
+typedef struct
+{
+    char name[32];
+    feasibility_test_fn fn;
+} sweep_test_t;
+
+// Running breakdown utilization statistics of one test
+typedef struct
+{
+    U64_T sets;
+    double sum;
+    double sumSquares;
+    double min;
+    double max;
+} sweep_breakdown_t;
+
+// Per-worker set buffers and tallies for the size being swept, indexed [point * numTests + test] and [point * TIER_COUNT + tier]
+typedef struct
+{
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *scaled;
+    U32_T *order;
+    U64_T *accepted;
+    U64_T *tiers;
+    sweep_breakdown_t *breakdown;
+} sweep_worker_t;
+
+typedef struct
+{
+    const gen_params_t *points;     // generator parameters of the utilization points of the size being swept
+    U32_T numPoints;
+    const gen_params_t *breakdown;  // generator parameters of the breakdown sample, numSets 0 for none
+    const sweep_test_t *tests;
+    int numTests;
+    sweep_worker_t *workers;
+} sweep_run_t;
+
+static void sweep_usage(FILE *out, const char *prog)
+{
+    fprintf(out, "usage: %s --sweep [-n N[,N...]] [-u FROM:TO:STEP] [-s SETS] [-b SETS] [-t TEST[,TEST...]] [-T TMIN:TMAX]\n"
+                 "          [-g GRANULARITY] [-d DMIN] [-e ENGINE] [-j JOBS] [-o FORMAT] [--seed SEED]\n", prog);
+    fprintf(out, "  -n, --sizes LIST      services per set (default 4,8,16,32,64,128,256)\n");
+    fprintf(out, "  -u, --util RANGE      utilization grid (default 0.5:1.0:0.01)\n");
+    fprintf(out, "  -s, --sets N          sets per grid point (default 1000)\n");
+    fprintf(out, "  -b, --breakdown N     sets per size scaled to their breakdown utilization (default 1000, 0 for none)\n");
+    fprintf(out, "  -t, --tests LIST      tests to sweep, by their batch names (default %s)\n", DEFAULT_SWEEP_TESTS);
+    fprintf(out, "  -T, --periods RANGE   log-uniform period range (default 1000:1000000)\n");
+    fprintf(out, "  -g, --granularity G   periods are multiples of G, for short hyperperiods in the sim tests (default 1)\n");
+    fprintf(out, "  -d, --dmin RATIO      deadlines uniform in [RATIO*T, T] (default 1, D=T)\n");
+    fprintf(out, "  -e, --engine ENGINE   optimized or reference exact test kernels\n");
+    fprintf(out, "  -j, --jobs N          threads (default one per CPU)\n");
+    fprintf(out, "  -o, --format FORMAT   text or csv (default text)\n");
+    fprintf(out, "      --seed SEED       generator seed (default 1)\n");
+}
+
+static int parse_sizes(const char *list, U32_T sizes[], int *numSizes)
+{
+    unsigned long v;
+    char *end;
+
+    *numSizes = 0;
+    while(*list)
+    {
+        errno = 0;
+        v = strtoul(list, &end, 10);
+        if(errno || end == list || v == 0 || v > 1000000 || (*end && *end != ',') || *numSizes == SWEEP_MAX_SIZES)
+            return FALSE;
+        sizes[(*numSizes)++] = (U32_T)v;
+        list = *end ? end + 1 : end;
+    }
+    return (*numSizes > 0);
+}
+
+static int parse_tests(const char *list, sweep_test_t tests[], int *numTests)
+{
+    sweep_test_t *test;
+    size_t len;
+
+    *numTests = 0;
+    while(*list)
+    {
+        len = strcspn(list, ",");
+        if(len == 0 || len >= sizeof(test->name) || *numTests == SWEEP_MAX_TESTS)
+            return FALSE;
+        test = &tests[*numTests];
+        memcpy(test->name, list, len);
+        test->name[len] = '\0';
+        if((test->fn = batch_find_test(test->name)) == NULL)
+            return FALSE;
+        (*numTests)++;
+        list += len;
+        if(*list == ',')
+            list++;
+    }
+    return (*numTests > 0);
+}
+
+static int sweep_worker_alloc(sweep_worker_t *w, U32_T maxServices, U32_T numPoints, int numTests)
+{
+    return (w->period = malloc(maxServices * sizeof(U32_T))) != NULL &&
+           (w->wcet = malloc(maxServices * sizeof(U32_T))) != NULL &&
+           (w->deadline = malloc(maxServices * sizeof(U32_T))) != NULL &&
+           (w->scaled = malloc(maxServices * sizeof(U32_T))) != NULL &&
+           (w->order = malloc(maxServices * sizeof(U32_T))) != NULL &&
+           (w->accepted = malloc((size_t)numPoints * numTests * sizeof(U64_T))) != NULL &&
+           (w->tiers = malloc((size_t)numPoints * TIER_COUNT * sizeof(U64_T))) != NULL &&
+           (w->breakdown = malloc(numTests * sizeof(sweep_breakdown_t))) != NULL;
+}
+
+static void sweep_worker_free(sweep_worker_t *w)
+{
+    free(w->period);
+    free(w->wcet);
+    free(w->deadline);
+    free(w->scaled);
+    free(w->order);
+    free(w->accepted);
+    free(w->tiers);
+    free(w->breakdown);
+}
+
+static void sweep_worker_clear(sweep_worker_t *w, U32_T numPoints, int numTests)
+{
+    int ti;
+
+    memset(w->accepted, 0, (size_t)numPoints * numTests * sizeof(U64_T));
+    memset(w->tiers, 0, (size_t)numPoints * TIER_COUNT * sizeof(U64_T));
+    for(ti=0; ti < numTests; ti++)
+    {
+        w->breakdown[ti].sets = 0;
+        w->breakdown[ti].sum = w->breakdown[ti].sumSquares = 0.0;
+        w->breakdown[ti].min = HUGE_VAL;
+        w->breakdown[ti].max = 0.0;
+    }
+}
+
+// Fold one worker's breakdown statistics into another's
+static void sweep_breakdown_merge(sweep_breakdown_t *into, const sweep_breakdown_t *from)
+{
+    into->sets += from->sets;
+    into->sum += from->sum;
+    into->sumSquares += from->sumSquares;
+    if(from->min < into->min)
+        into->min = from->min;
+    if(from->max > into->max)
+        into->max = from->max;
+}
+
+// Utilization of the worker's set with every WCET raised to ceil(scale*C(j)), left in w->scaled
+static double sweep_scale(sweep_worker_t *w, U32_T n, double scale)
+{
+    double c, u = 0.0;
+    U32_T j;
+
+    for(j=0; j < n; j++)
+    {
+        c = ceil(scale * (double)w->wcet[j]);
+        w->scaled[j] = (c < (double)UINT_MAX) ? (U32_T)c : UINT_MAX;
+        u += (double)w->scaled[j] / (double)w->period[j];
+    }
+    return u;
+}
+
+/* Breakdown utilization of the worker's set under test: the utilization of the most heavily scaled copy the test accepts, 0 when
+ * not even the copy with 1 tick WCETs is.  No set above U = 1 is feasible on one core, so the scale that takes the set to U = 1
+ * bounds the search.
+ */
+static double sweep_breakdown(sweep_worker_t *w, U32_T n, feasibility_test_fn test)
+{
+    double lo = 0.0, hi, mid, u = 0.0, scaledU, best = 0.0;
+    U32_T j;
+
+    for(j=0; j < n; j++)
+        u += (double)w->wcet[j] / (double)w->period[j];
+    if(u <= 0.0)
+        return 0.0;
+
+    // the copy at hi has U >= 1, as the rounding only adds work, so it can only be accepted at exactly 1
+    hi = 1.0 / u;
+    if((scaledU = sweep_scale(w, n, hi)) <= 1.0 && test(n, w->period, w->scaled, w->deadline) == TRUE)
+        return scaledU;
+
+    // a scale interval of width h spans about h*u of utilization, so the interval is narrowed in terms of that
+    while((hi - lo) * u > SWEEP_BREAKDOWN_PRECISION)
+    {
+        mid = lo + (hi - lo) / 2;
+        scaledU = sweep_scale(w, n, mid);
+        if(test(n, w->period, w->scaled, w->deadline) == TRUE)
+        {
+            lo = mid;
+            best = scaledU;
+        }
+        else
+            hi = mid;
+    }
+
+    return best;
+}
+
+// Run sets begin..end-1 of the size being swept: the sets of each utilization point in turn, then the breakdown sample
+static void sweep_range(void *context, U32_T worker, U64_T begin, U64_T end)
+{
+    sweep_run_t *run = context;
+    sweep_worker_t *w = &run->workers[worker];
+    U64_T k, setIndex, perPoint = run->points[0].numSets, numAcceptance = (U64_T)run->numPoints * perPoint;
+    tiered_counters_t before;
+    const gen_params_t *gen;
+    sweep_breakdown_t *b;
+    U32_T point, n;
+    double u;
+    int ti, tier;
+
+    for(k=begin; k < end; k++)
+    {
+        if(k < numAcceptance)
+        {
+            point = (U32_T)(k / perPoint);
+            gen = &run->points[point];
+            setIndex = k % perPoint;
+        }
+        else
+        {
+            gen = run->breakdown;
+            setIndex = k - numAcceptance;
+        }
+
+        n = gen->numServices;
+        if(!gen_task_set(gen, setIndex, w->period, w->wcet, w->deadline))
+            continue;
+        priority_order(n, w->period, w->wcet, w->deadline, PRIORITY_DM, w->order);
+        priority_permute(n, w->order, w->period, w->wcet, w->deadline);
+
+        for(ti=0; ti < run->numTests; ti++)
+        {
+            if(k >= numAcceptance)
+            {
+                u = sweep_breakdown(w, n, run->tests[ti].fn);
+                b = &w->breakdown[ti];
+                b->sets++;
+                b->sum += u;
+                b->sumSquares += u * u;
+                if(u < b->min)
+                    b->min = u;
+                if(u > b->max)
+                    b->max = u;
+                continue;
+            }
+
+            before = tiered_counters;
+            if(run->tests[ti].fn(n, w->period, w->wcet, w->deadline) == TRUE)
+                w->accepted[point * run->numTests + ti]++;
+            if(run->tests[ti].fn == tiered_feasibility)
+            {
+                for(tier=0; tier < TIER_COUNT; tier++)
+                    w->tiers[point * TIER_COUNT + tier] += tiered_counters.decided[tier] - before.decided[tier];
+            }
+        }
+    }
+}
+
+// Print the merged tallies of one size, in worker 0
+static void sweep_print(const sweep_run_t *run, int csv)
+{
+    const sweep_worker_t *w = &run->workers[0];
+    const sweep_breakdown_t *b;
+    const gen_params_t *gen;
+    U64_T sets, accepted;
+    double mean, sd;
+    U32_T point;
+    int ti, tier, isTier;
+
+    for(point=0; point < run->numPoints; point++)
+    {
+        gen = &run->points[point];
+        sets = gen->numSets;
+        for(ti=0; ti < run->numTests; ti++)
+        {
+            accepted = w->accepted[point * run->numTests + ti];
+            isTier = (run->tests[ti].fn == tiered_feasibility);
+            if(csv)
+            {
+                printf("acceptance,%u,%.4f,%s,%llu,%llu,%.6f", gen->numServices, gen->utilization, run->tests[ti].name, sets,
+                       accepted, (double)accepted / sets);
+                for(tier=0; tier < TIER_COUNT; tier++)
+                {
+                    if(isTier)
+                        printf(",%llu", w->tiers[point * TIER_COUNT + tier]);
+                    else
+                        printf(",");
+                }
+                printf(",,,,\n");
+            }
+            else
+            {
+                printf("%7u %6.3f  %-8s %7.3f", gen->numServices, gen->utilization, run->tests[ti].name,
+                       (double)accepted / sets);
+                for(tier=0; isTier && tier < TIER_COUNT; tier++)
+                    printf(" %7.3f", (double)w->tiers[point * TIER_COUNT + tier] / sets);
+                printf("\n");
+            }
+        }
+    }
+
+    for(ti=0; run->breakdown->numSets && ti < run->numTests; ti++)
+    {
+        b = &w->breakdown[ti];
+        mean = b->sets ? b->sum / b->sets : 0.0;
+        sd = (b->sets > 1) ? sqrt(fmax(0.0, (b->sumSquares - b->sets * mean * mean) / (b->sets - 1))) : 0.0;
+        if(csv)
+            printf("breakdown,%u,,%s,%llu,,,,,,,%.6f,%.6f,%.6f,%.6f\n", run->breakdown->numServices, run->tests[ti].name,
+                   b->sets, mean, sd, b->sets ? b->min : 0.0, b->max);
+        else
+            printf("%7u %6s  %-8s %7.3f %7.3f %7.3f %7.3f  over %llu sets\n", run->breakdown->numServices, "bkdn",
+                   run->tests[ti].name, mean, sd, b->sets ? b->min : 0.0, b->max, b->sets);
+    }
+    fflush(stdout);
+}
+
+int sweep_main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        {"sizes", required_argument, NULL, 'n'},
+        {"util", required_argument, NULL, 'u'},
+        {"sets", required_argument, NULL, 's'},
+        {"breakdown", required_argument, NULL, 'b'},
+        {"tests", required_argument, NULL, 't'},
+        {"periods", required_argument, NULL, 'T'},
+        {"granularity", required_argument, NULL, 'g'},
+        {"dmin", required_argument, NULL, 'd'},
+        {"engine", required_argument, NULL, 'e'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"format", required_argument, NULL, 'o'},
+        {"seed", required_argument, NULL, 'S'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    U32_T sizes[SWEEP_MAX_SIZES] = {4, 8, 16, 32, 64, 128, 256}, numWorkers = 0, maxServices = 0, perSize = 0, point, wi;
+    sweep_test_t tests[SWEEP_MAX_TESTS];
+    int numSizes = 7, numTests, opt, si, ti, csv = FALSE, rc = 0;
+    double uFrom = 0.5, uTo = 1.0, uStep = 0.01, u, dmin = 1.0;
+    unsigned long numSets = 1000, breakdownSets = 1000, tmin = 1000, tmax = 1000000, granularity = 1, value;
+    sweep_run_t run = {0};
+    gen_params_t *points = NULL, breakdown;
+    U64_T seed = 1;
+    char *end;
+
+    parse_tests(DEFAULT_SWEEP_TESTS, tests, &numTests);
+
+    while((opt = getopt_long(argc, argv, "n:u:s:b:t:T:g:d:e:j:o:h", long_options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+                if(!parse_sizes(optarg, sizes, &numSizes))
+                {
+                    fprintf(stderr, "%s: bad size list \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'u':
+                if(sscanf(optarg, "%lf:%lf:%lf", &uFrom, &uTo, &uStep) != 3 || uFrom <= 0.0 || uTo < uFrom || uStep <= 0.0)
+                {
+                    fprintf(stderr, "%s: bad utilization range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 's':
+            case 'b':
+            case 'g':
+            case 'j':
+                errno = 0;
+                value = strtoul(optarg, &end, 10);
+                if(errno || end == optarg || *end || ((opt == 's' || opt == 'g') && value == 0) || value > 4294967295UL)
+                {
+                    fprintf(stderr, "%s: bad count \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                if(opt == 's') numSets = value;
+                else if(opt == 'b') breakdownSets = value;
+                else if(opt == 'g') granularity = value;
+                else numWorkers = (U32_T)value;
+                break;
+            case 't':
+                if(!parse_tests(optarg, tests, &numTests))
+                {
+                    fprintf(stderr, "%s: bad test list \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'T':
+                if(sscanf(optarg, "%lu:%lu", &tmin, &tmax) != 2 || tmin == 0 || tmax < tmin || tmax > 4294967295UL)
+                {
+                    fprintf(stderr, "%s: bad period range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'd':
+                if(sscanf(optarg, "%lf", &dmin) != 1 || dmin <= 0.0 || dmin > 1.0)
+                {
+                    fprintf(stderr, "%s: bad deadline ratio \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'e':
+                if(strcmp(optarg, "reference") == 0)
+                    feasibility_engine = ENGINE_REFERENCE;
+                else if(strcmp(optarg, "optimized") == 0)
+                    feasibility_engine = ENGINE_OPTIMIZED;
+                else
+                {
+                    fprintf(stderr, "%s: unknown engine \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'o':
+                if(strcmp(optarg, "csv") == 0)
+                    csv = TRUE;
+                else if(strcmp(optarg, "text") != 0)
+                {
+                    fprintf(stderr, "%s: unknown format \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'S':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'h': sweep_usage(stdout, argv[0]); return 0;
+            default:  sweep_usage(stderr, argv[0]); return 2;
+        }
+    }
+    if(optind < argc || granularity > tmax)
+    {
+        sweep_usage(stderr, argv[0]);
+        return 2;
+    }
+
+    feasibility_verbosity = VERBOSITY_SILENT;
+    if(numWorkers == 0)
+        numWorkers = parallel_default_workers();
+
+    // the small tolerance lets the end of the utilization range survive accumulated rounding in the step
+    for(u=uFrom; u <= uTo + 1e-9; u += uStep)
+        perSize++;
+    for(si=0; si < numSizes; si++)
+        if(sizes[si] > maxServices)
+            maxServices = sizes[si];
+
+    if((points = calloc(perSize, sizeof(*points))) == NULL || (run.workers = calloc(numWorkers, sizeof(*run.workers))) == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        free(points);
+        return 1;
+    }
+    for(wi=0; wi < numWorkers && rc == 0; wi++)
+        if(!sweep_worker_alloc(&run.workers[wi], maxServices, perSize, numTests))
+            rc = 1;
+
+    run.points = points;
+    run.numPoints = perSize;
+    run.breakdown = &breakdown;
+    run.tests = tests;
+    run.numTests = numTests;
+
+    if(rc == 0)
+    {
+        if(csv)
+            printf("record,n,U,test,sets,accepted,ratio,tier_utilization,tier_hyperbolic,tier_harmonic,tier_exact,"
+                   "breakdown_mean,breakdown_sd,breakdown_min,breakdown_max\n");
+        else
+            printf("%7s %6s  %-8s %7s  (tier rows: decided by utilization, hyperbolic, harmonic, exact; bkdn rows: breakdown "
+                   "mean, sd, min, max)\n", "n", "U", "test", "accept");
+    }
+
+    for(si=0; si < numSizes && rc == 0; si++)
+    {
+        // every size gets its own generator seeds, one per utilization point and one for the breakdown sample
+        for(point=0, u=uFrom; point < perSize; point++, u += uStep)
+        {
+            gen_default_params(&points[point]);
+            points[point].numSets = numSets;
+            points[point].seed = seed + ((U64_T)si * (perSize + 1) + point) * 0x9E3779B97F4A7C15ULL;
+            points[point].numServices = sizes[si];
+            points[point].utilization = u;
+            points[point].discard = (u > 1.0);
+            points[point].minPeriod = (U32_T)tmin;
+            points[point].maxPeriod = (U32_T)tmax;
+            points[point].granularity = (U32_T)granularity;
+            points[point].minDeadlineRatio = dmin;
+        }
+        // the sample is scaled to its breakdown anyway, so it is drawn at the bottom of the range
+        breakdown = points[0];
+        breakdown.numSets = breakdownSets;
+        breakdown.seed = seed + ((U64_T)si * (perSize + 1) + perSize) * 0x9E3779B97F4A7C15ULL;
+
+        for(wi=0; wi < numWorkers; wi++)
+            sweep_worker_clear(&run.workers[wi], perSize, numTests);
+
+        if(!parallel_for((U64_T)perSize * numSets + breakdownSets, numWorkers, 16, sweep_range, &run))
+        {
+            rc = 1;
+            break;
+        }
+
+        // merge into worker 0
+        for(wi=1; wi < numWorkers; wi++)
+        {
+            for(point=0; point < perSize * numTests; point++)
+                run.workers[0].accepted[point] += run.workers[wi].accepted[point];
+            for(point=0; point < perSize * TIER_COUNT; point++)
+                run.workers[0].tiers[point] += run.workers[wi].tiers[point];
+            for(ti=0; ti < numTests; ti++)
+                sweep_breakdown_merge(&run.workers[0].breakdown[ti], &run.workers[wi].breakdown[ti]);
+        }
+
+        sweep_print(&run, csv);
+    }
+
+    if(rc)
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+    for(wi=0; wi < numWorkers; wi++)
+        sweep_worker_free(&run.workers[wi]);
+    free(run.workers);
+    free(points);
+    return rc;
+}
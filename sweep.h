@@ -0,0 +1,29 @@
+// Acceptance ratio and breakdown utilization sweeps
+//
+// The average case study of Lehoczky, Sha and Ding: over random sets of each size, the fraction a test accepts at each
+// utilization, and the utilization at which each set stops being accepted.  sweep_main drives the generator (gen.h) over a grid
+// of set sizes and utilizations on all cores (parallel.h), with the sets in deadline monotonic order, and reports for each size
+// and test:
+//
+//     acceptance ratio        the fraction of the sets of each utilization point the test accepts; for the tiered test also
+//                             the fraction each tier decided, which shows where the cheap bounds stop deciding
+//     breakdown utilization   the mean, standard deviation, minimum and maximum over a further sample of sets of the
+//                             utilization at which each stops being accepted, found by scaling every WCET to ceil(a*C(j)) and
+//                             bisecting on a until the utilization is known to within SWEEP_BREAKDOWN_PRECISION
+//
+// No set or per-set result is kept: each worker adds its sets straight into its own counters and sums for the grid points of
+// the size being swept, and the workers' tallies are merged and printed once the size is done.  The memory used is the same
+// whatever the number of sets, and the sets are shared out by the work stealing loop, so the run time falls with the cores.
+//
+// The breakdown bisection assumes a test accepts every scaled down copy of a set it accepts, which holds for the analytical
+// tests and the RM, DM and EDF simulations.
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+// Width of the utilization interval the breakdown of a set is narrowed to
+#define SWEEP_BREAKDOWN_PRECISION 1e-4
+
+int sweep_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,106 @@
+// Tiered fixed priority admission - see tiered.h
+
+#include <stdlib.h>
+
+#include "tiered.h"
+
+const char *tier_names[] = {"utilization", "hyperbolic", "harmonic", "exact"};
+
+__thread tiered_counters_t tiered_counters;
+
+// Per-thread chain tails for the harmonic chain search, and a context for callers of the common signature
+static __thread U32_T *tiered_tails = NULL;
+static __thread U32_T tiered_capacity = 0;
+static __thread feasibility_context_t tiered_ctx;
+
+/* Split the periods, in increasing order, into harmonic chains and return how many there are, or maxChains + 1 as soon as more
+ * than maxChains are needed (or memory ran out).  Each period extends the chain with the longest period that divides it, or
+ * starts a new one.  Any split gives a valid bound, and this greedy one finds a single chain whenever the set is harmonic.
+ */
+U32_T tiered_harmonic_chains(U32_T numServices, const U32_T period[], U32_T maxChains)
+{
+    U32_T *p, i, c, best, numChains = 0;
+
+    if(maxChains > numServices)
+        maxChains = numServices;
+    if(maxChains > tiered_capacity)
+    {
+        if((p = realloc(tiered_tails, maxChains * sizeof(U32_T))) == NULL)
+            return maxChains + 1;
+        tiered_tails = p;
+        tiered_capacity = maxChains;
+    }
+
+    for(i=0; i < numServices; i++)
+    {
+        best = numChains;
+        for(c=0; c < numChains; c++)
+            if(period[i] % tiered_tails[c] == 0 && (best == numChains || tiered_tails[c] > tiered_tails[best]))
+                best = c;
+
+        if(best == numChains && numChains++ == maxChains)
+            return maxChains + 1;
+        tiered_tails[best] = period[i];
+    }
+
+    return numChains;
+}
+
+// TRUE when the utilization bounds hold for the set: services in rate monotonic order and no deadline shorter than its period
+static int tiered_bounds_apply(const feasibility_context_t *ctx)
+{
+    U32_T i;
+
+    for(i=0; i < ctx->numServices; i++)
+        if(ctx->deadline[i] < ctx->period[i] || (i > 0 && ctx->period[i] < ctx->period[i-1]))
+            return FALSE;
+
+    return TRUE;
+}
+
+// Record the tier that decided the set
+static int tiered_decide(int tier, int *decidedBy, int feasible)
+{
+    tiered_counters.decided[tier]++;
+    if(decidedBy)
+        *decidedBy = tier;
+    return feasible;
+}
+
+/* Decide the feasibility of the bound set in array priority order, returning TRUE or FALSE as completion_time_feasibility, with
+ * the tier that decided it in *tier when tier is not NULL.
+ */
+int tiered_feasibility_context(feasibility_context_t *ctx, int *tier)
+{
+    double product = 1.0, utilization = context_utilization(ctx);
+    U32_T i, maxChains;
+
+    // the rounded sum is close enough to tell all but the sets near U = 1 apart without the exact comparison
+    if(utilization > 1.0 - TIERED_BOUND_MARGIN && context_utilization_compare(ctx) > 0)
+        return tiered_decide(TIER_UTILIZATION, tier, FALSE);
+
+    if(tiered_bounds_apply(ctx))
+    {
+        for(i=0; i < ctx->numServices; i++)
+            product *= (double)ctx->wcet[i] / (double)ctx->period[i] + 1.0;
+        if(product <= 2.0 * (1.0 - TIERED_BOUND_MARGIN))
+            return tiered_decide(TIER_HYPERBOLIC, tier, TRUE);
+
+        // the chain bound falls with K, so find the most chains it still accepts the utilization for; one chain takes U <= 1,
+        // which holds here exactly
+        for(maxChains=1; maxChains < ctx->numServices; maxChains++)
+            if(utilization > feasibility_lub(maxChains + 1) * (1.0 - TIERED_BOUND_MARGIN))
+                break;
+        if(tiered_harmonic_chains(ctx->numServices, ctx->period, maxChains) <= maxChains)
+            return tiered_decide(TIER_HARMONIC, tier, TRUE);
+    }
+
+    return tiered_decide(TIER_EXACT, tier, completion_time_feasibility(ctx->numServices, (U32_T *)ctx->period,
+                                                                      (U32_T *)ctx->wcet, (U32_T *)ctx->deadline));
+}
+
+int tiered_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[])
+{
+    context_bind(&tiered_ctx, numServices, period, wcet, deadline);
+    return tiered_feasibility_context(&tiered_ctx, NULL);
+}
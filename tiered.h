@@ -0,0 +1,47 @@
+// Tiered fixed priority admission
+//
+// The exact tests cost a fixed point per service, while most sets are decided by a test that looks at each service once.
+// tiered_feasibility runs the cheap tests first and only falls through to the completion test when they are inconclusive:
+//
+//     TIER_UTILIZATION  U > 1, compared exactly: not feasible under any scheduler
+//     TIER_HYPERBOLIC   the hyperbolic bound of Bini, Buttazzo and Buttazzo, product of (U(i) + 1) <= 2, which accepts every
+//                       set the Liu and Layland LUB accepts and more
+//     TIER_HARMONIC     the bound of Kuo and Mok for periods that split into K harmonic chains (each period dividing the next),
+//                       U <= K(2^(1/K) - 1); a fully harmonic set (K = 1) is feasible up to U = 1 exactly, as Ex-4 is
+//     TIER_EXACT        the completion test
+//
+// The bounds are for rate monotonic priorities with D >= T, so they are only tried when the array order is by period and no
+// deadline is shorter than its period; otherwise the set goes straight to the completion test.  Each bound is checked with a
+// small margin for the rounding of the sum, so a bound never accepts a set the completion test would reject.
+//
+// tiered_counters counts the sets each tier decided on the calling thread, like feasibility_counters.
+
+#ifndef TIERED_H
+#define TIERED_H
+
+#include "context.h"
+#include "feasibility.h"
+
+#define TIER_UTILIZATION 0
+#define TIER_HYPERBOLIC 1
+#define TIER_HARMONIC 2
+#define TIER_EXACT 3
+#define TIER_COUNT 4
+
+// Relative margin below the bounds for the rounding of the double precision sums, which stays well above it for any set size
+#define TIERED_BOUND_MARGIN 1e-9
+
+extern const char *tier_names[];
+
+typedef struct
+{
+    U64_T decided[TIER_COUNT];
+} tiered_counters_t;
+
+extern __thread tiered_counters_t tiered_counters;
+
+int tiered_feasibility(U32_T numServices, U32_T period[], U32_T wcet[], U32_T deadline[]);
+int tiered_feasibility_context(feasibility_context_t *ctx, int *tier);
+U32_T tiered_harmonic_chains(U32_T numServices, const U32_T period[], U32_T maxChains);
+
+#endif
@@ -0,0 +1,704 @@
+// Differential verification of the feasibility tests - see verify.h
+
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "edf.h"
+#include "gen.h"
+#include "parallel.h"
+#include "partition.h"
+#include "priority.h"
+#include "rta.h"
+#include "schedpoint.h"
+#include "sensitivity.h"
+#include "sim.h"
+#include "tiered.h"
+#include "verify.h"
+
+#define VERIFY_MAX_SIZES 32
+
+// How a variant's verdict must relate to the reference of its group
+#define VERIFY_REFERENCE 0
+#define VERIFY_EXACT 1
+#define VERIFY_SUFFICIENT 2
+
+// Verdict of a variant that was not run on a set
+#define VERIFY_SKIPPED (-1)
+
+// Rounds of shrinking a reproducer; each round tries every service and WCET once
+#define VERIFY_SHRINK_ROUNDS 16
+
+typedef struct
+{
+    const char *name;
+    int kind;           // VERIFY_*
+    int reference;      // index of the group's reference variant (see verify_reference)
+} verify_variant_t;
+
+// Indexes into verify_variants[]
+enum
+{
+    V_CT_REF, V_CT, V_CT_SCALAR, V_CT_O, V_SP, V_INC, V_PART, V_TIER, V_SENS, V_MAXC, V_MINT, V_SIM_DM, V_SP_REF, V_LUB,
+    V_DM, V_QPA, V_SIM_EDF, NUM_VARIANTS
+};
+
+static const verify_variant_t verify_variants[NUM_VARIANTS] =
+{
+    {"ct-ref",    VERIFY_REFERENCE,  V_CT_REF},
+    {"ct",        VERIFY_EXACT,      V_CT_REF},
+    {"ct-scalar", VERIFY_EXACT,      V_CT_REF},
+    {"ct-o",      VERIFY_EXACT,      V_CT_REF},
+    {"sp",        VERIFY_EXACT,      V_CT_REF},
+    {"inc",       VERIFY_EXACT,      V_CT_REF},
+    {"part-1",    VERIFY_EXACT,      V_CT_REF},
+    {"tier",      VERIFY_EXACT,      V_CT_REF},
+    {"sens",      VERIFY_EXACT,      V_CT_REF},
+    {"maxC",      VERIFY_EXACT,      V_CT_REF},
+    {"minT",      VERIFY_EXACT,      V_CT_REF},
+    {"sim-dm",    VERIFY_EXACT,      V_CT_REF},
+    {"sp-ref",    VERIFY_SUFFICIENT, V_CT_REF},
+    {"lub",       VERIFY_SUFFICIENT, V_CT_REF},
+    {"dm",        VERIFY_SUFFICIENT, V_CT_REF},
+    {"qpa",       VERIFY_REFERENCE,  V_QPA},
+    {"sim-edf",   VERIFY_EXACT,      V_QPA},
+};
+
+// Per-worker buffers and tallies; the set being checked lives in the worker so it can be shrunk in place
+typedef struct
+{
+    U32_T capacity;
+    U32_T *period;
+    U32_T *wcet;
+    U32_T *deadline;
+    U32_T *order;
+    U32_T *limits;
+    rta_state_t state;
+    partition_t part;
+    U64_T sets;
+    U64_T accepted[NUM_VARIANTS];
+    U64_T skipped[NUM_VARIANTS];
+    U64_T compared[NUM_VARIANTS];   // sets with a verdict from both the variant and its reference, or it was the reference
+    U64_T agreed[NUM_VARIANTS];
+    U64_T disagreements;
+} verify_worker_t;
+
+typedef struct
+{
+    const gen_params_t *points;     // generator parameters of each grid point
+    U32_T numPoints;
+    U64_T simLimit;                 // largest hyperperiod simulated
+    U64_T maxReports;
+    U64_T numReported;
+    verify_worker_t *workers;
+    pthread_mutex_t lock;           // serializes the reports and numReported
+    int failed;                     // memory ran out on some worker
+} verify_run_t;
+
+static void verify_usage(FILE *out, const char *prog)
+{
+    int idx;
+
+    fprintf(out, "usage: %s --verify [-n N[,N...]] [-u FROM:TO:STEP] [-s SETS] [-T TMIN:TMAX] [-g GRANULARITY] [-d DMIN]\n"
+                 "          [-D DMAX] [-H LIMIT] [-j JOBS] [-k REPORTS] [--seed SEED]\n", prog);
+    fprintf(out, "  -n, --sizes LIST      services per set (default 4,8,16,32)\n");
+    fprintf(out, "  -u, --util RANGE      utilization grid (default 0.5:1.0:0.05)\n");
+    fprintf(out, "  -s, --sets N          sets per grid point and deadline range (default 5000)\n");
+    fprintf(out, "  -T, --periods RANGE   log-uniform period range (default 10:1000)\n");
+    fprintf(out, "  -g, --granularity G   periods are multiples of G, which keeps hyperperiods short (default 50)\n");
+    fprintf(out, "  -d, --dmin RATIO      shortest deadline as a fraction of the period (default 0.5)\n");
+    fprintf(out, "  -D, --dmax RATIO      longest deadline as a fraction of the period (default 2); each grid point is run\n"
+                 "                        with D = T, with deadlines uniform in [DMIN*T, T] and, above 1, in [DMIN*T, DMAX*T]\n");
+    fprintf(out, "  -H, --sim-limit L     simulate only sets with a hyperperiod of at most L (default 1000000, 0 for none)\n");
+    fprintf(out, "  -j, --jobs N          threads (default one per CPU)\n");
+    fprintf(out, "  -k, --reports N       most disagreements to print (default 20); all are still counted\n");
+    fprintf(out, "      --seed SEED       generator seed (default 1)\n\n");
+    fprintf(out, "Variants:");
+    for(idx=0; idx < NUM_VARIANTS; idx++)
+        fprintf(out, " %s", verify_variants[idx].name);
+    fprintf(out, "\n");
+}
+
+static int verify_reserve(verify_worker_t *w, U32_T count)
+{
+    U32_T *p;
+
+    if(count <= w->capacity)
+        return TRUE;
+
+    if((p = realloc(w->period, count * sizeof(U32_T))) == NULL) return FALSE;
+    w->period = p;
+    if((p = realloc(w->wcet, count * sizeof(U32_T))) == NULL) return FALSE;
+    w->wcet = p;
+    if((p = realloc(w->deadline, count * sizeof(U32_T))) == NULL) return FALSE;
+    w->deadline = p;
+    if((p = realloc(w->order, count * sizeof(U32_T))) == NULL) return FALSE;
+    w->order = p;
+    if((p = realloc(w->limits, count * sizeof(U32_T))) == NULL) return FALSE;
+    w->limits = p;
+
+    w->capacity = count;
+    return TRUE;
+}
+
+static void verify_worker_free(verify_worker_t *w)
+{
+    free(w->period);
+    free(w->wcet);
+    free(w->deadline);
+    free(w->order);
+    free(w->limits);
+    rta_state_free(&w->state);
+    partition_free(&w->part);
+}
+
+/* Services with the same deadline and period may take either order in deadline monotonic order, but rta_state_t keeps them in
+ * the order they are added, and partitioning adds them by decreasing utilization.  Sort each run of such ties by decreasing
+ * WCET, so that every variant analyzes the same priority order.
+ */
+static void verify_order_ties(verify_worker_t *w, U32_T n)
+{
+    U32_T i, j, wcet;
+
+    for(i=1; i < n; i++)
+    {
+        wcet = w->wcet[i];
+        for(j=i; j > 0 && w->deadline[j-1] == w->deadline[i] && w->period[j-1] == w->period[i] && w->wcet[j-1] < wcet; j--)
+            w->wcet[j] = w->wcet[j-1];
+        w->wcet[j] = wcet;
+    }
+}
+
+/* Run every variant on the worker's first n services, which are in deadline monotonic order, with each verdict TRUE, FALSE or
+ * VERIFY_SKIPPED.  Ties are first put in the order of verify_order_ties.  Returns FALSE if memory ran out.
+ */
+static int verify_run_variants(verify_worker_t *w, U32_T n, U64_T simLimit, int verdict[NUM_VARIANTS])
+{
+    rta_overheads_t none = {NULL, NULL, 0};
+    U64_T hyperperiod, demand, term;
+    U32_T i, j, k;
+    int rc, implicit = TRUE, arbitrary = FALSE;
+    double scale;
+
+    verify_order_ties(w, n);
+    for(i=0; i < n; i++)
+    {
+        w->order[i] = i;
+        implicit = implicit && (w->deadline[i] == w->period[i]);
+        arbitrary = arbitrary || (w->deadline[i] > w->period[i]);
+    }
+
+    // the reference engines and the DM quick test only analyze first jobs, which is exact only while D <= T
+    verdict[V_CT_REF] = verdict[V_SP_REF] = verdict[V_DM] = VERIFY_SKIPPED;
+    if(!arbitrary)
+    {
+        verdict[V_CT_REF] = completion_time_feasibility_fp(n, w->period, w->wcet, w->deadline) == TRUE;
+        verdict[V_SP_REF] = scheduling_point_feasibility_naive(n, w->period, w->wcet, w->deadline) == TRUE;
+        verdict[V_DM] = dm_quick_test(n, w->wcet, w->period, w->deadline) == TRUE;
+    }
+    verdict[V_CT] = rta_feasibility(n, w->period, w->wcet, w->deadline) == TRUE;
+    // the same analysis through an explicit order never takes the vector kernels
+    verdict[V_CT_SCALAR] = rta_response_times_ordered(n, w->order, w->period, w->wcet, w->deadline, NULL, 0) == TRUE;
+    verdict[V_CT_O] = rta_response_times_overheads(n, w->period, w->wcet, w->deadline, &none, NULL,
+                                                   RTA_STOP_ON_MISS) == TRUE;
+    verdict[V_SP] = scheduling_point_feasibility_reduced(n, w->period, w->wcet, w->deadline) == TRUE;
+    verdict[V_TIER] = tiered_feasibility(n, w->period, w->wcet, w->deadline) == TRUE;
+    // the utilization bound assumes deadlines at the periods, so it only takes part for implicit deadline sets
+    verdict[V_LUB] = implicit ? rate_monotonic_least_upper_bound(n, w->period, w->wcet, w->deadline) == TRUE : VERIFY_SKIPPED;
+    verdict[V_QPA] = edf_demand_feasibility(n, w->period, w->wcet, w->deadline) == TRUE;
+
+    /* Lowest priority first, so that every service added updates the cached response times of those below it.  The state
+     * places a service after those with the same deadline and period, so a run of such ties goes in highest first to keep the
+     * order of the array.
+     */
+    rta_state_clear(&w->state);
+    for(i=n; i > 0; i=j)
+    {
+        for(j=i-1; j > 0 && w->deadline[j-1] == w->deadline[i-1] && w->period[j-1] == w->period[i-1]; j--)
+            ;
+        for(k=j; k < i; k++)
+            rta_state_add(&w->state, w->period[k], w->wcet[k], w->deadline[k], NULL);
+    }
+    if(w->state.numServices != n)
+        return FALSE;
+    verdict[V_INC] = (w->state.numMisses == 0);
+
+    // one core takes every service exactly when the set is feasible, and the -m margins must agree on whether it is
+    if((rc = partition_services(&w->part, n, w->period, w->wcet, w->deadline, 1, PARTITION_FF)) < 0)
+        return FALSE;
+    verdict[V_PART] = rc;
+    if(sensitivity_wcet_scale(n, w->period, w->wcet, w->deadline, &scale) < 0 ||
+       (verdict[V_MAXC] = sensitivity_wcet_limits(n, w->period, w->wcet, w->deadline, w->limits)) < 0 ||
+       (verdict[V_MINT] = sensitivity_period_limits(n, w->period, w->wcet, w->deadline, w->limits)) < 0)
+        return FALSE;
+    verdict[V_SENS] = (scale >= 1.0);
+
+    // one hyperperiod from the synchronous release shows every miss only when the demand of a hyperperiod fits in it; beyond
+    // that the backlog of deadlines past the periods keeps growing from one hyperperiod to the next
+    verdict[V_SIM_DM] = verdict[V_SIM_EDF] = VERIFY_SKIPPED;
+    hyperperiod = sim_hyperperiod(n, w->period);
+    for(i=0, demand=0; i < n && hyperperiod && demand <= hyperperiod; i++)
+        if(__builtin_mul_overflow((U64_T)w->wcet[i], hyperperiod / w->period[i], &term) ||
+           __builtin_add_overflow(demand, term, &demand))
+            demand = ~0ULL;
+    if(hyperperiod && hyperperiod <= simLimit && demand <= hyperperiod)
+    {
+        if((rc = sim_run(n, w->period, w->wcet, w->deadline, SIM_DM, hyperperiod, NULL)) < 0 ||
+           (verdict[V_SIM_EDF] = sim_run(n, w->period, w->wcet, w->deadline, SIM_EDF, hyperperiod, NULL)) < 0)
+            return FALSE;
+        verdict[V_SIM_DM] = rc;
+    }
+
+    return TRUE;
+}
+
+/* The variant a verdict is checked against on this set.  ct-ref only analyzes first jobs, so for a set with a deadline beyond
+ * its period the simulator stands in for it, or when the simulator did not run either, the integer engine with its busy period
+ * analysis.
+ */
+static int verify_reference(const int verdict[NUM_VARIANTS], int variant)
+{
+    int ref = verify_variants[variant].reference;
+
+    if(ref == V_CT_REF && verdict[ref] == VERIFY_SKIPPED)
+        ref = (verdict[V_SIM_DM] != VERIFY_SKIPPED) ? V_SIM_DM : V_CT;
+    return ref;
+}
+
+// TRUE when the verdict of variant is consistent with its reference, FALSE when not, VERIFY_SKIPPED when there is no pair
+static int verify_check(const int verdict[NUM_VARIANTS], int variant)
+{
+    int ref = verify_reference(verdict, variant);
+
+    if(ref == variant || verdict[variant] == VERIFY_SKIPPED || verdict[ref] == VERIFY_SKIPPED)
+        return VERIFY_SKIPPED;
+    if(verify_variants[variant].kind == VERIFY_EXACT)
+        return verdict[variant] == verdict[ref];
+    return !verdict[variant] || verdict[ref];
+}
+
+// The first variant whose verdict contradicts its reference, or -1 when they all agree
+static int verify_first_disagreement(const int verdict[NUM_VARIANTS])
+{
+    int idx;
+
+    for(idx=0; idx < NUM_VARIANTS; idx++)
+        if(verify_check(verdict, idx) == FALSE)
+            return idx;
+    return -1;
+}
+
+// TRUE when the worker's first n services still show the disagreement of variant
+static int verify_still_disagrees(verify_worker_t *w, U32_T n, U64_T simLimit, int variant)
+{
+    int verdict[NUM_VARIANTS];
+
+    return n > 0 && verify_run_variants(w, n, simLimit, verdict) && verify_check(verdict, variant) == FALSE;
+}
+
+/* Shrink the worker's set while variant keeps disagreeing with its reference: drop each service in turn, then halve each WCET
+ * for as long as that keeps it, until a round changes nothing.  Returns the services left.
+ */
+static U32_T verify_shrink(verify_worker_t *w, U32_T n, U64_T simLimit, int variant)
+{
+    U32_T i, j, saved[3], round;
+    int changed = TRUE;
+
+    for(round=0; changed && round < VERIFY_SHRINK_ROUNDS; round++)
+    {
+        changed = FALSE;
+        for(i=n; i-- > 0 && n > 1; )
+        {
+            saved[0] = w->period[i]; saved[1] = w->wcet[i]; saved[2] = w->deadline[i];
+            for(j=i; j+1 < n; j++)
+            {
+                w->period[j] = w->period[j+1];
+                w->wcet[j] = w->wcet[j+1];
+                w->deadline[j] = w->deadline[j+1];
+            }
+            if(verify_still_disagrees(w, n - 1, simLimit, variant))
+            {
+                n--;
+                changed = TRUE;
+                continue;
+            }
+            for(j=n-1; j > i; j--)
+            {
+                w->period[j] = w->period[j-1];
+                w->wcet[j] = w->wcet[j-1];
+                w->deadline[j] = w->deadline[j-1];
+            }
+            w->period[i] = saved[0]; w->wcet[i] = saved[1]; w->deadline[i] = saved[2];
+        }
+
+        for(i=0; i < n; i++)
+        {
+            while(w->wcet[i] > 0)
+            {
+                saved[1] = w->wcet[i];
+                w->wcet[i] /= 2;
+                if(!verify_still_disagrees(w, n, simLimit, variant))
+                {
+                    w->wcet[i] = saved[1];
+                    break;
+                }
+                changed = TRUE;
+            }
+        }
+    }
+
+    return n;
+}
+
+static void verify_print_set(FILE *out, const char *label, const verify_worker_t *w, U32_T n)
+{
+    U32_T i;
+
+    fprintf(out, "%s:", label);
+    for(i=0; i < n; i++)
+        fprintf(out, " %u,%u,%u", w->period[i], w->wcet[i], w->deadline[i]);
+    fputc('\n', out);
+}
+
+static void verify_print_verdicts(FILE *out, const int verdict[NUM_VARIANTS])
+{
+    int idx;
+
+    fprintf(out, "#  ");
+    for(idx=0; idx < NUM_VARIANTS; idx++)
+    {
+        if(verdict[idx] == VERIFY_SKIPPED)
+            fprintf(out, " %s=-", verify_variants[idx].name);
+        else
+            fprintf(out, " %s=%d", verify_variants[idx].name, verdict[idx]);
+    }
+    fputc('\n', out);
+}
+
+// Report the disagreement on the worker's set, which is shrunk first
+static void verify_report(verify_run_t *run, verify_worker_t *w, U64_T setIndex, const gen_params_t *gen, U32_T n,
+                          int variant, const int verdict[NUM_VARIANTS])
+{
+    char label[64];
+    int shrunk[NUM_VARIANTS], ref = verify_reference(verdict, variant);
+
+    pthread_mutex_lock(&run->lock);
+    if(run->numReported >= run->maxReports)
+    {
+        pthread_mutex_unlock(&run->lock);
+        return;
+    }
+    run->numReported++;
+    pthread_mutex_unlock(&run->lock);
+
+    // the set as generated, then the reproducer it shrinks to, each printed in one piece
+    snprintf(label, sizeof(label), "n%u-u%.3f-d%.2f-s%llu", gen->numServices, gen->utilization, gen->maxDeadlineRatio,
+             setIndex);
+    pthread_mutex_lock(&run->lock);
+    printf("# %s: %s=%d but %s=%d\n", label, verify_variants[variant].name, verdict[variant], verify_variants[ref].name,
+           verdict[ref]);
+    verify_print_verdicts(stdout, verdict);
+    verify_print_set(stdout, label, w, n);
+    pthread_mutex_unlock(&run->lock);
+
+    n = verify_shrink(w, n, run->simLimit, variant);
+    strncat(label, "-min", sizeof(label) - strlen(label) - 1);
+    verify_run_variants(w, n, run->simLimit, shrunk);
+    pthread_mutex_lock(&run->lock);
+    verify_print_verdicts(stdout, shrunk);
+    verify_print_set(stdout, label, w, n);
+    fflush(stdout);
+    pthread_mutex_unlock(&run->lock);
+}
+
+// Check sets begin..end-1 of the run, numbered across the grid points in order
+static void verify_range(void *context, U32_T worker, U64_T begin, U64_T end)
+{
+    verify_run_t *run = context;
+    verify_worker_t *w = &run->workers[worker];
+    const gen_params_t *gen;
+    int verdict[NUM_VARIANTS], check[NUM_VARIANTS], served[NUM_VARIANTS], contradicted[NUM_VARIANTS], idx, ref, variant;
+    U64_T k, setIndex;
+
+    for(k=begin; k < end && !run->failed; k++)
+    {
+        gen = &run->points[k / run->points[0].numSets];
+        setIndex = k % run->points[0].numSets;
+        if(!verify_reserve(w, gen->numServices))
+        {
+            run->failed = TRUE;
+            return;
+        }
+        if(!gen_task_set(gen, setIndex, w->period, w->wcet, w->deadline))
+            continue;
+        priority_order(gen->numServices, w->period, w->wcet, w->deadline, PRIORITY_DM, w->order);
+        priority_permute(gen->numServices, w->order, w->period, w->wcet, w->deadline);
+
+        if(!verify_run_variants(w, gen->numServices, run->simLimit, verdict))
+        {
+            run->failed = TRUE;
+            return;
+        }
+
+        /* A reference is compared on every set some variant was checked against it, and agrees when all of those did, so the
+         * summary shows the reference rows taking part as well
+         */
+        w->sets++;
+        memset(served, 0, sizeof(served));
+        memset(contradicted, 0, sizeof(contradicted));
+        for(idx=0; idx < NUM_VARIANTS; idx++)
+        {
+            if((check[idx] = verify_check(verdict, idx)) == VERIFY_SKIPPED)
+                continue;
+            ref = verify_reference(verdict, idx);
+            served[ref] = TRUE;
+            contradicted[ref] = contradicted[ref] || !check[idx];
+        }
+        for(idx=0; idx < NUM_VARIANTS; idx++)
+        {
+            if(verdict[idx] == VERIFY_SKIPPED)
+                w->skipped[idx]++;
+            else
+                w->accepted[idx] += verdict[idx];
+            if(check[idx] != VERIFY_SKIPPED || served[idx])
+            {
+                w->compared[idx]++;
+                w->agreed[idx] += (check[idx] != FALSE && !contradicted[idx]);
+            }
+        }
+
+        if((variant = verify_first_disagreement(verdict)) >= 0)
+        {
+            w->disagreements++;
+            verify_report(run, w, setIndex, gen, gen->numServices, variant, verdict);
+        }
+    }
+}
+
+static int parse_sizes(const char *list, U32_T sizes[], int *numSizes)
+{
+    unsigned long v;
+    char *end;
+
+    *numSizes = 0;
+    while(*list)
+    {
+        errno = 0;
+        v = strtoul(list, &end, 10);
+        if(errno || end == list || v == 0 || v > 1000000 || (*end && *end != ',') || *numSizes == VERIFY_MAX_SIZES)
+            return FALSE;
+        sizes[(*numSizes)++] = (U32_T)v;
+        list = *end ? end + 1 : end;
+    }
+    return (*numSizes > 0);
+}
+
+int verify_main(int argc, char *argv[])
+{
+    static const struct option long_options[] =
+    {
+        {"sizes", required_argument, NULL, 'n'},
+        {"util", required_argument, NULL, 'u'},
+        {"sets", required_argument, NULL, 's'},
+        {"periods", required_argument, NULL, 'T'},
+        {"granularity", required_argument, NULL, 'g'},
+        {"dmin", required_argument, NULL, 'd'},
+        {"dmax", required_argument, NULL, 'D'},
+        {"sim-limit", required_argument, NULL, 'H'},
+        {"jobs", required_argument, NULL, 'j'},
+        {"reports", required_argument, NULL, 'k'},
+        {"seed", required_argument, NULL, 'S'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    U32_T sizes[VERIFY_MAX_SIZES] = {4, 8, 16, 32}, numWorkers = 0, point, perSize = 0, numRanges, range, uncompared = 0;
+    int numSizes = 4, opt, si, idx;
+    double uFrom = 0.5, uTo = 1.0, uStep = 0.05, u, dmin = 0.5, dmax = 2.0, rangeMin[3], rangeMax[3];
+    unsigned long numSets = 5000, tmin = 10, tmax = 1000, granularity = 50, value;
+    unsigned long long simLimit = 1000000, maxReports = 20;
+    verify_run_t run = {0};
+    gen_params_t *points = NULL;
+    U64_T seed = 1, totals[NUM_VARIANTS] = {0}, skipped[NUM_VARIANTS] = {0}, compared[NUM_VARIANTS] = {0};
+    U64_T agreed[NUM_VARIANTS] = {0}, sets = 0, disagreements = 0;
+    char *end;
+
+    while((opt = getopt_long(argc, argv, "n:u:s:T:g:d:D:H:j:k:h", long_options, NULL)) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+                if(!parse_sizes(optarg, sizes, &numSizes))
+                {
+                    fprintf(stderr, "%s: bad size list \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'u':
+                if(sscanf(optarg, "%lf:%lf:%lf", &uFrom, &uTo, &uStep) != 3 || uFrom <= 0.0 || uTo < uFrom || uStep <= 0.0)
+                {
+                    fprintf(stderr, "%s: bad utilization range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'T':
+                if(sscanf(optarg, "%lu:%lu", &tmin, &tmax) != 2 || tmin == 0 || tmax < tmin || tmax > 4294967295UL)
+                {
+                    fprintf(stderr, "%s: bad period range \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'd':
+                if(sscanf(optarg, "%lf", &dmin) != 1 || dmin <= 0.0 || dmin > 1.0)
+                {
+                    fprintf(stderr, "%s: bad deadline ratio \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 'D':
+                if(sscanf(optarg, "%lf", &dmax) != 1 || dmax < 1.0 || dmax > 1000.0)
+                {
+                    fprintf(stderr, "%s: bad deadline ratio \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                break;
+            case 's':
+            case 'g':
+            case 'j':
+            case 'H':
+            case 'k':
+                errno = 0;
+                value = strtoul(optarg, &end, 10);
+                if(errno || end == optarg || *end || ((opt == 's' || opt == 'g') && value == 0) ||
+                   (opt != 'H' && opt != 'k' && value > 4294967295UL))
+                {
+                    fprintf(stderr, "%s: bad count \"%s\"\n", argv[0], optarg);
+                    return 2;
+                }
+                if(opt == 's') numSets = value;
+                else if(opt == 'g') granularity = value;
+                else if(opt == 'j') numWorkers = (U32_T)value;
+                else if(opt == 'H') simLimit = value;
+                else maxReports = value;
+                break;
+            case 'S':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'h': verify_usage(stdout, argv[0]); return 0;
+            default:  verify_usage(stderr, argv[0]); return 2;
+        }
+    }
+    if(optind < argc || granularity > tmax)
+    {
+        verify_usage(stderr, argv[0]);
+        return 2;
+    }
+
+    feasibility_verbosity = VERBOSITY_SILENT;
+    if(numWorkers == 0)
+        numWorkers = parallel_default_workers();
+
+    /* One generator setup per grid point, with the sets of every point numbered one after another; the small tolerance lets the
+     * end of the utilization range survive accumulated rounding in the step.  Each point is run with D = T, so lub takes part,
+     * then with every D <= T, then with D up to dmax*T, dropping the ranges dmin and dmax make the same as the one before.
+     */
+    rangeMin[0] = rangeMax[0] = 1.0;
+    numRanges = 1;
+    if(dmin < 1.0)
+    {
+        rangeMin[numRanges] = dmin;
+        rangeMax[numRanges++] = 1.0;
+    }
+    if(dmax > 1.0)
+    {
+        rangeMin[numRanges] = dmin;
+        rangeMax[numRanges++] = dmax;
+    }
+    for(u=uFrom; u <= uTo + 1e-9; u += uStep)
+        perSize += numRanges;
+    if((points = calloc((size_t)numSizes * perSize, sizeof(*points))) == NULL ||
+       (run.workers = calloc(numWorkers, sizeof(*run.workers))) == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        free(points);
+        return 1;
+    }
+    point = 0;
+    for(si=0; si < numSizes; si++)
+    {
+        for(u=uFrom; u <= uTo + 1e-9; u += uStep)
+        {
+            for(range=0; range < numRanges; range++, point++)
+            {
+                gen_default_params(&points[point]);
+                points[point].numSets = numSets;
+                points[point].seed = seed + (U64_T)point * 0x9E3779B97F4A7C15ULL;
+                points[point].numServices = sizes[si];
+                points[point].utilization = u;
+                points[point].discard = (u > 1.0);
+                points[point].minPeriod = (U32_T)tmin;
+                points[point].maxPeriod = (U32_T)tmax;
+                points[point].granularity = (U32_T)granularity;
+                points[point].minDeadlineRatio = rangeMin[range];
+                points[point].maxDeadlineRatio = rangeMax[range];
+            }
+        }
+    }
+
+    run.points = points;
+    run.numPoints = point;
+    run.simLimit = simLimit;
+    run.maxReports = maxReports;
+    for(idx=0; idx < (int)numWorkers; idx++)
+    {
+        rta_state_init(&run.workers[idx].state);
+        partition_init(&run.workers[idx].part);
+    }
+    pthread_mutex_init(&run.lock, NULL);
+
+    if(!parallel_for((U64_T)run.numPoints * numSets, numWorkers, 16, verify_range, &run))
+        run.failed = TRUE;
+
+    for(idx=0; idx < (int)numWorkers; idx++)
+    {
+        sets += run.workers[idx].sets;
+        disagreements += run.workers[idx].disagreements;
+        for(si=0; si < NUM_VARIANTS; si++)
+        {
+            totals[si] += run.workers[idx].accepted[si];
+            skipped[si] += run.workers[idx].skipped[si];
+            compared[si] += run.workers[idx].compared[si];
+            agreed[si] += run.workers[idx].agreed[si];
+        }
+        verify_worker_free(&run.workers[idx]);
+    }
+
+    printf("# %llu sets on %u threads, %llu disagreements\n", sets, numWorkers, disagreements);
+    printf("# %-10s %10s %10s %10s %10s\n", "variant", "accepted", "compared", "agreed", "skipped");
+    for(idx=0; idx < NUM_VARIANTS; idx++)
+    {
+        printf("# %-10s %10llu %10llu %10llu %10llu\n", verify_variants[idx].name, totals[idx], compared[idx], agreed[idx],
+               skipped[idx]);
+        uncompared += (compared[idx] == 0);
+    }
+
+    pthread_mutex_destroy(&run.lock);
+    free(run.workers);
+    free(points);
+    if(run.failed)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+    // a variant never compared was not verified at all, which must not pass for agreement
+    if(uncompared)
+    {
+        for(idx=0; idx < NUM_VARIANTS; idx++)
+            if(compared[idx] == 0)
+                fprintf(stderr, "%s: %s was not compared on any set\n", argv[0], verify_variants[idx].name);
+        return 1;
+    }
+    return disagreements ? 1 : 0;
+}
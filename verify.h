@@ -0,0 +1,30 @@
+// Differential verification of the feasibility tests
+//
+// The exact tests are implemented several times over: the original double precision completion test, the integer engine with
+// its vector kernels and with its scalar loop, the overhead analysis with no overheads, the reduced scheduling point engine,
+// the incremental rta_state_t, partitioning onto one core, the tiered test, the sensitivity searches and the event driven
+// simulator.  They must all agree, and the sufficient tests must never accept a set the exact ones reject.  verify_main runs
+// generated sets through every variant on all cores and reports each set on which they disagree:
+//
+//     fixed priority (deadline monotonic order)   ct-ref is the reference; ct, ct-scalar, ct-o, sp, inc, part-1, tier, sens
+//                                                 (critical scaling factor >= 1), maxC, minT and sim-dm must match it, and
+//                                                 sp-ref (which skips the deadline as a point), lub and dm may only reject
+//                                                 more
+//     EDF                                         qpa is the reference; sim-edf must match it
+//
+// Each grid point is generated with every D = T, with every D <= T and with deadlines up to a multiple of the
+// periods.  ct-ref, sp-ref and dm only analyze first jobs, so they sit out a set with a deadline past its period, and sim-dm
+// stands in as the reference, or ct where the set is not simulated.  The simulator is only run when the hyperperiod is within
+// a limit and the utilization is at most 1, so the default periods are short multiples of a common granularity, and lub,
+// which assumes deadlines at the periods, only on implicit deadline sets.  The summary gives, for each variant, the sets it
+// accepted, was compared on against its reference (a reference on the sets something was checked against it), agreed on and
+// was skipped on; a variant compared on no set fails the run like a disagreement.  A set the variants disagree on is shrunk
+// before it is reported, by dropping services and lowering WCETs for as long as the same disagreement remains, and printed in
+// the batch input format so it can be replayed with batch mode.
+
+#ifndef VERIFY_H
+#define VERIFY_H
+
+int verify_main(int argc, char *argv[]);
+
+#endif